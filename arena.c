@@ -0,0 +1,75 @@
+/** Reserva memória para as plataformas em regiões contíguas.
+ *  Uma arena pode conter uma plataforma ou um lote inteiro delas, e é
+ *  reiniciada de uma vez entre simulações, sem chamadas a free para
+ *  cada bomba ou guindaste.
+ */
+
+#include <stdbool.h>
+#ifndef CONTROLADOR_EMBARCADO
+#include <stdlib.h>
+#endif
+
+#include "arena.h"
+
+#ifndef CONTROLADOR_EMBARCADO
+/* Cria uma arena com a capacidade especificada, em bytes, usando uma
+única reserva de memória. */
+Arena *CriarArena(size_t capacidade)
+{
+    // A arena e sua região de memória são reservadas juntas; a região
+    // começa logo após a estrutura, no próximo endereço alinhado.
+    size_t cabecalho = ALINHAR_NA_ARENA(sizeof(Arena));
+    Arena *arena = aligned_alloc(ALINHAMENTO_DA_ARENA,
+                                 ALINHAR_NA_ARENA(cabecalho + capacidade));
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+    inicializarArena(arena, (unsigned char *)arena + cabecalho,
+                     capacidade);
+    arena->propria = true;
+    return arena;
+}
+#endif
+
+/* Inicializa uma arena sobre uma região de memória fornecida
+externamente, que deve estar alinhada a ALINHAMENTO_DA_ARENA. */
+void inicializarArena(Arena *arena, void *memoria, size_t capacidade)
+{
+    arena->memoria = memoria;
+    arena->capacidade = capacidade;
+    arena->usados = 0;
+    arena->propria = false;
+}
+
+/* Reserva um bloco alinhado da arena. Retorna um apontador nulo se
+não houver espaço suficiente. */
+void *reservarNaArena(Arena *arena, size_t bytes)
+{
+    bytes = ALINHAR_NA_ARENA(bytes);
+    if (bytes > arena->capacidade - arena->usados)
+    {
+        return NULL;
+    }
+    void *bloco = arena->memoria + arena->usados;
+    arena->usados += bytes;
+    return bloco;
+}
+
+/* Descarta todos os blocos reservados da arena, em tempo constante. */
+void reiniciarArena(Arena *arena)
+{
+    arena->usados = 0;
+}
+
+#ifndef CONTROLADOR_EMBARCADO
+/* Remove a arena, e todos os blocos reservados dela, da memória. */
+void removerArena(Arena *arena)
+{
+    // Arenas sobre memória externa não são liberadas.
+    if (arena != NULL && arena->propria)
+    {
+        free(arena);
+    }
+}
+#endif
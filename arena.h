@@ -0,0 +1,56 @@
+#ifndef _ARENA
+#define _ARENA
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/** Região contígua de memória, da qual blocos são reservados em
+sequência. Os blocos não são liberados individualmente: toda a arena
+é reiniciada de uma vez, em tempo constante, o que permite criar e
+descartar muitas plataformas sem custo mensurável. */
+typedef struct {
+    // Início da região de memória.
+    unsigned char *memoria;
+    // Tamanho da região de memória, em bytes.
+    size_t capacidade;
+    // Quantidade de bytes já reservados.
+    size_t usados;
+    // true se a região foi reservada pela própria arena, false se foi
+    // fornecida externamente (por exemplo, um vetor estático).
+    bool propria;
+} Arena;
+
+/* Alinhamento de todos os blocos reservados de uma arena, em bytes. */
+#define ALINHAMENTO_DA_ARENA 16
+
+/* Arredonda um tamanho, em bytes, para o próximo múltiplo do
+alinhamento da arena. */
+#define ALINHAR_NA_ARENA(bytes) \
+    (((bytes) + ALINHAMENTO_DA_ARENA - 1) \
+     & ~(size_t)(ALINHAMENTO_DA_ARENA - 1))
+
+/** Protótipos das funções públicas. */
+
+#ifndef CONTROLADOR_EMBARCADO
+/* Cria uma arena com a capacidade especificada, em bytes, usando uma
+única reserva de memória. */
+Arena *CriarArena(size_t capacidade);
+#endif
+
+/* Inicializa uma arena sobre uma região de memória fornecida
+externamente, que deve estar alinhada a ALINHAMENTO_DA_ARENA. */
+void inicializarArena(Arena *arena, void *memoria, size_t capacidade);
+
+/* Reserva um bloco alinhado da arena. Retorna um apontador nulo se
+não houver espaço suficiente. */
+void *reservarNaArena(Arena *arena, size_t bytes);
+
+/* Descarta todos os blocos reservados da arena, em tempo constante. */
+void reiniciarArena(Arena *arena);
+
+#ifndef CONTROLADOR_EMBARCADO
+/* Remove a arena, e todos os blocos reservados dela, da memória. */
+void removerArena(Arena *arena);
+#endif
+
+#endif // _ARENA
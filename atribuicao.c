@@ -0,0 +1,105 @@
+/** Atribui a energia e o custo da termelétrica aos consumidores da
+ *  plataforma: sistemas auxiliares, bombas e guindastes. A atribuição
+ *  é feita a cada passo da simulação, com a potência de cada classe
+ *  depois do ajuste da demanda, e acumulada por hora do dia, para que
+ *  o custo de cada classe possa ser conhecido por hora e por turno.
+ */
+
+#include <stdbool.h>
+#ifndef CONTROLADOR_EMBARCADO
+#include <stdio.h>
+#endif
+#include <string.h>
+
+#include "atribuicao.h"
+#include "energia.h"
+
+/* Nomes das classes de consumidores, usados nos relatórios. */
+static const char *nomesDosConsumidores[NUM_CONSUMIDORES] = {
+    "Auxiliar", "Bombas", "Guindastes"
+};
+
+/* Zera todas as parcelas de uma atribuição. */
+void zerarAtribuicao(Atribuicao *atribuicao)
+{
+    memset(atribuicao, 0, sizeof(Atribuicao));
+}
+
+/* Atribui a energia fornecida pela termelétrica durante um passo (um
+segundo) às classes de consumidores, de acordo com os componentes
+ativos depois do ajuste da demanda. */
+void atribuirPasso(Atribuicao *atribuicao, Bombas *bombas,
+                   Guindastes *guindastes, int horario,
+                   double fracaoDaTermeletrica)
+{
+    // Se a termelétrica não fornece energia, não há o que atribuir.
+    if (fracaoDaTermeletrica <= 0)
+    {
+        return;
+    }
+    double potencias[NUM_CONSUMIDORES] = {
+        P_AUXILIAR,
+        bombas->ativas * P_BOMBA,
+        guindastes->ativos * P_GUINDASTE
+    };
+    double total = potencias[0] + potencias[1] + potencias[2];
+    // Energia fornecida pela termelétrica no passo, em kWh, por kW
+    // demandado pela plataforma.
+    double fator = fracaoDaTermeletrica * P_TERMELETRICA / 3600 / total;
+    for (int i = 0; i < NUM_CONSUMIDORES; i++)
+    {
+        atribuicao->energia[horario][i] += potencias[i] * fator;
+    }
+}
+
+#ifndef CONTROLADOR_EMBARCADO
+/* Mostra uma linha do relatório de atribuição, somando as horas de
+inicio até fim - 1. Função local. */
+static void mostrarLinha(Atribuicao *atribuicao, int inicio, int fim)
+{
+    double total = 0;
+    for (int i = 0; i < NUM_CONSUMIDORES; i++)
+    {
+        double energia = 0;
+        for (int hora = inicio; hora < fim; hora++)
+        {
+            energia += atribuicao->energia[hora][i];
+        }
+        total += energia;
+        printf(" | %12.3lf kWh R$ %12.3lf", energia,
+               energia * C_TERMELETRICA);
+    }
+    printf(" | R$ %12.3lf\n", total * C_TERMELETRICA);
+}
+
+/* Mostra a energia e o custo de cada classe de consumidores no
+terminal, por turno dos guindastes e, se porHora for true, também por
+hora do dia. */
+void mostrarAtribuicao(Atribuicao *atribuicao, bool porHora)
+{
+    // Turnos definidos pelo horário de funcionamento dos guindastes.
+    const int turnos[] = {0, 6, 14, 18, 24};
+    printf("Custo por consumidor:\n");
+    printf("  Horário    ");
+    for (int i = 0; i < NUM_CONSUMIDORES; i++)
+    {
+        printf(" | %-33s", nomesDosConsumidores[i]);
+    }
+    printf(" | Total\n");
+    if (porHora)
+    {
+        for (int hora = 0; hora < 24; hora++)
+        {
+            printf("  %02d:00-%02d:00", hora, hora + 1);
+            mostrarLinha(atribuicao, hora, hora + 1);
+        }
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        printf("  %02d:00-%02d:00", turnos[i], turnos[i+1]);
+        mostrarLinha(atribuicao, turnos[i], turnos[i+1]);
+    }
+    printf("  Total      ");
+    mostrarLinha(atribuicao, 0, 24);
+}
+#endif
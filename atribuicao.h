@@ -0,0 +1,47 @@
+#ifndef _ATRIBUICAO
+#define _ATRIBUICAO
+
+#include <stdbool.h>
+
+#include "bombas.h"
+#include "guindastes.h"
+
+/* Classes de consumidores da plataforma, às quais a energia fornecida
+pela termelétrica é atribuída. */
+typedef enum {
+    CONSUMIDOR_AUXILIAR,
+    CONSUMIDOR_BOMBAS,
+    CONSUMIDOR_GUINDASTES,
+    NUM_CONSUMIDORES
+} Consumidor;
+
+/** Divisão da energia fornecida pela termelétrica entre as classes de
+consumidores, para cada hora do dia. A energia das turbinas eólicas e
+as perdas dos inversores são divididas proporcionalmente à potência de
+cada classe, então a soma das parcelas é igual à energia fornecida
+pela termelétrica. */
+typedef struct {
+    // Energia atribuída a cada classe em cada hora do dia, em kWh.
+    double energia[24][NUM_CONSUMIDORES];
+} Atribuicao;
+
+/** Protótipos das funções públicas. */
+
+/* Zera todas as parcelas de uma atribuição. */
+void zerarAtribuicao(Atribuicao *atribuicao);
+
+/* Atribui a energia fornecida pela termelétrica durante um passo (um
+segundo) às classes de consumidores, de acordo com os componentes
+ativos depois do ajuste da demanda. */
+void atribuirPasso(Atribuicao *atribuicao, Bombas *bombas,
+                   Guindastes *guindastes, int horario,
+                   double fracaoDaTermeletrica);
+
+#ifndef CONTROLADOR_EMBARCADO
+/* Mostra a energia e o custo de cada classe de consumidores no
+terminal, por turno dos guindastes e, se porHora for true, também por
+hora do dia. */
+void mostrarAtribuicao(Atribuicao *atribuicao, bool porHora);
+#endif
+
+#endif // _ATRIBUICAO
@@ -0,0 +1,91 @@
+/** Compara o tempo das versões escalar e vetorial de
+ *  atualizarGuindastes, para a plataforma padrão (10 guindastes) e para
+ *  uma frota grande de guindastes. Além do tempo por chamada, confere
+ *  se as duas versões terminam exatamente no mesmo estado.
+ *  Compilado com 'make bench'.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "guindastes.h"
+
+/* Número de chamadas medidas em cada comparação, para a plataforma
+padrão. Frotas maiores usam menos chamadas, já que a reativação dos
+guindastes por progresso cresce com o quadrado do número deles. */
+#define REPETICOES 20000000
+
+/* Retorna o tempo atual, em segundos. */
+static double agora(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/* Mede o tempo por chamada de atualizarGuindastes com a versão
+especificada, em ns, simulando dias de operação. Navios pequenos são
+atracados sempre que o anterior fica cheio, para que o limite de
+guindastes carregando seja atingido com frequência. */
+static double medirGuindastes(Guindastes *guindastes,
+                              KernelDosGuindastes kernel)
+{
+    guindastes->kernel = kernel;
+    int repeticoes = REPETICOES / guindastes->totais * NUM_GUINDASTES
+                     / guindastes->totais * NUM_GUINDASTES;
+    double inicio = agora();
+    for (int i = 0; i < repeticoes; i++)
+    {
+        atualizarNavio(guindastes, 1 + i % 97);
+        // Reduz o máximo de guindastes ativos de vez em quando, para
+        // exercitar também a reativação por progresso.
+        guindastes->ativosMax = guindastes->totais
+                                - ((i >> 12) % 64 == 0 ? 2 : 0);
+        atualizarGuindastes(guindastes, (i / 3600) % 24);
+    }
+    return (agora() - inicio) * 1e9 / repeticoes;
+}
+
+/* Retorna true se dois grupos de guindastes estão no mesmo estado. */
+static bool guindastesIguais(Guindastes *a, Guindastes *b)
+{
+    return a->ativos == b->ativos
+        && a->carregando == b->carregando
+        && a->estadoDoNavio == b->estadoDoNavio
+        && !memcmp(a->progressos, b->progressos, a->totais * sizeof(int))
+        && !memcmp(a->estados, b->estados, a->totais * sizeof(bool));
+}
+
+/* Compara as versões de atualizarGuindastes para um número de
+guindastes. Retorna true se todas chegaram ao mesmo estado. */
+static bool compararGuindastes(int num_guindastes)
+{
+    Guindastes *escalar = CriarGuindastes(num_guindastes);
+    Guindastes *generico = CriarGuindastes(num_guindastes);
+    if (escalar == NULL || generico == NULL)
+    {
+        exit(2);
+    }
+    double tEscalar = medirGuindastes(escalar, kernelEscalarDosGuindastes);
+    double tGenerico = medirGuindastes(generico,
+                                       kernelGenericoDosGuindastes);
+    bool iguais = guindastesIguais(escalar, generico);
+    printf("atualizarGuindastes (%d guindastes)\n", num_guindastes);
+    printf("  Escalar:       %6.2lf ns/chamada\n", tEscalar);
+    printf("  Vetorial:      %6.2lf ns/chamada (%.2lfx)\n",
+           tGenerico, tEscalar / tGenerico);
+    printf("  Estados finais: %s\n", iguais ? "iguais" : "DIFERENTES");
+    removerGuindastes(escalar);
+    removerGuindastes(generico);
+    return iguais;
+}
+
+int main(void)
+{
+    bool iguais = compararGuindastes(NUM_GUINDASTES);
+    iguais = compararGuindastes(64) && iguais;
+    return !iguais;
+}
@@ -0,0 +1,237 @@
+/** Biblioteca libplataforma.so: expõe a simulação das plataformas para
+ *  programas externos, sem a interface de texto do programa principal.
+ *  As plataformas são criadas em lotes, em uma única arena, e avançadas
+ *  em paralelo; um programa em Python, por exemplo, pode dar milhões de
+ *  passos com uma única chamada e ler os estados diretamente da memória
+ *  da biblioteca.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "biblioteca.h"
+#include "cache.h"
+#include "energia.h"
+
+/* Retorna a plataforma de índice especificado, ou um apontador nulo se
+o índice não existir. Função local. */
+static Plataforma *plataformaDoLote(Lote *lote, int indice)
+{
+    if (lote == NULL || indice < 0 || indice >= lote->quantidade)
+    {
+        return NULL;
+    }
+    return &lote->plataformas[indice];
+}
+
+/* Cria um lote de plataformas iguais, com o número de séries de bombas
+e de guindastes especificado, todas com o relógio no início e com um navio da
+capacidade especificada (0 para nenhum navio). Retorna um apontador
+nulo se não houver memória suficiente. */
+Lote *CriarLote(int quantidade, int num_bombas, int num_guindastes,
+                int capacidadeDoNavio)
+{
+    if (quantidade < 1 || num_bombas < 1 || num_guindastes < 1)
+    {
+        return NULL;
+    }
+    Arena *arena = CriarArena(ALINHAR_NA_ARENA(sizeof(Lote))
+                              + tamanhoDasPlataformas(quantidade,
+                                                      num_bombas,
+                                                      num_guindastes)
+                              + ALINHAR_NA_ARENA(quantidade
+                                                 * sizeof(double)));
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+    Lote *lote = reservarNaArena(arena, sizeof(Lote));
+    lote->plataformas = CriarPlataformasNaArena(arena, quantidade,
+                                                num_bombas,
+                                                num_guindastes);
+    lote->custos = reservarNaArena(arena, quantidade * sizeof(double));
+    lote->quantidade = quantidade;
+    lote->arena = arena;
+    for (int i = 0; i < quantidade; i++)
+    {
+        atualizarNavio(lote->plataformas[i].guindastes, capacidadeDoNavio);
+        lote->custos[i] = 0;
+    }
+    return lote;
+}
+
+/* Dá uma quantidade de passos em todas as plataformas do lote, em
+paralelo. Retorna o custo desses passos, somado entre as
+plataformas. */
+double passosDoLote(Lote *lote, int64_t passos)
+{
+    double custo = 0;
+    #pragma omp parallel for schedule(static) reduction(+:custo)
+    for (int i = 0; i < lote->quantidade; i++)
+    {
+        custo += passosDaPlataforma(lote, i, passos);
+    }
+    return custo;
+}
+
+/* Dá uma quantidade de passos em uma plataforma do lote. Retorna o
+custo desses passos, ou -1 se o índice não existir. */
+double passosDaPlataforma(Lote *lote, int indice, int64_t passos)
+{
+    Plataforma *plataforma = plataformaDoLote(lote, indice);
+    if (plataforma == NULL)
+    {
+        return -1;
+    }
+    double custo = passosN(passos, plataforma->bombas,
+                           plataforma->guindastes, &plataforma->relogio,
+                           false, NULL);
+    lote->custos[indice] += custo;
+    return custo;
+}
+
+/* Avança uma plataforma do lote até o navio atracado ficar cheio.
+Retorna o custo desses passos, ou -1 se o índice não existir. */
+double passosAteNavioCheio(Lote *lote, int indice)
+{
+    Plataforma *plataforma = plataformaDoLote(lote, indice);
+    if (plataforma == NULL)
+    {
+        return -1;
+    }
+    double custo = passosNavio(plataforma->bombas, plataforma->guindastes,
+                               &plataforma->relogio, false, NULL);
+    lote->custos[indice] += custo;
+    return custo;
+}
+
+/* Estima quando o navio atracado em uma plataforma do lote ficará
+cheio, e o custo até lá, sem avançar a simulação. Retorna false se o
+índice não existir ou se o navio não ficar cheio. Usa o cache
+indicado pela variável de ambiente PLATAFORMA_CACHE, se houver. */
+bool estimarNavioDoLote(Lote *lote, int indice,
+                        EstimativaDoNavio *estimativa)
+{
+    Plataforma *plataforma = plataformaDoLote(lote, indice);
+    if (plataforma == NULL)
+    {
+        return false;
+    }
+    return estimarNavioComCache(plataforma, estimativa);
+}
+
+/* Coloca o resumo do estado de uma plataforma do lote no endereço de
+memória especificado. Retorna false se o índice não existir. */
+bool consultarPlataforma(Lote *lote, int indice, Consulta *consulta)
+{
+    Plataforma *plataforma = plataformaDoLote(lote, indice);
+    if (plataforma == NULL)
+    {
+        return false;
+    }
+    Bombas *bombas = plataforma->bombas;
+    Guindastes *guindastes = plataforma->guindastes;
+    int segundos = segundosDoDia(plataforma->relogio);
+    consulta->hora = segundos / SEGUNDOS_NA_HORA;
+    consulta->minuto = segundos / 60 % 60;
+    consulta->segundo = segundos % 60;
+    consulta->bombasAtivas = bombas->ativas;
+    consulta->bombasTotais = bombas->totais;
+    consulta->guindastesAtivos = guindastes->ativos;
+    consulta->guindastesTotais = guindastes->totais;
+    consulta->guindastesAtivosMax = guindastes->ativosMax;
+    consulta->carregando = guindastes->carregando;
+    consulta->estadoDoNavio = guindastes->estadoDoNavio;
+    consulta->barrisPreparados = guindastes->barrisPreparados;
+    consulta->custo = lote->custos[indice];
+    consulta->relogio = plataforma->relogio;
+    return true;
+}
+
+/* Retornam as listas de estados de uma plataforma do lote e a lista de
+custos de todas as plataformas, sem cópia. As listas continuam válidas
+até o lote ser removido. Retornam um apontador nulo se o índice não
+existir. */
+int *progressosDosGuindastes(Lote *lote, int indice)
+{
+    Plataforma *plataforma = plataformaDoLote(lote, indice);
+    return plataforma == NULL ? NULL : plataforma->guindastes->progressos;
+}
+bool *estadosDosGuindastes(Lote *lote, int indice)
+{
+    Plataforma *plataforma = plataformaDoLote(lote, indice);
+    return plataforma == NULL ? NULL : plataforma->guindastes->estados;
+}
+bool *estadosDasBombas(Lote *lote, int indice)
+{
+    Plataforma *plataforma = plataformaDoLote(lote, indice);
+    return plataforma == NULL ? NULL : plataforma->bombas->estados;
+}
+double *custosDoLote(Lote *lote)
+{
+    return lote->custos;
+}
+
+/* Alteram o estado de uma plataforma do lote, como os comandos B, G, n
+e e/E do modo interativo. Retornam false se o índice não existir ou se
+a alteração não for possível. */
+bool alterarBombasDaPlataforma(Lote *lote, int indice, int ativas)
+{
+    Plataforma *plataforma = plataformaDoLote(lote, indice);
+    if (plataforma == NULL || ativas < 0
+        || ativas > plataforma->bombas->totais
+        || plataforma->bombas->luzVermelha)
+    {
+        return false;
+    }
+    alterarBombasAtivas(plataforma->bombas, ativas);
+    return true;
+}
+bool alterarGuindastesDaPlataforma(Lote *lote, int indice, int ativosMax)
+{
+    Plataforma *plataforma = plataformaDoLote(lote, indice);
+    if (plataforma == NULL || ativosMax < 0
+        || ativosMax > plataforma->guindastes->totais)
+    {
+        return false;
+    }
+    plataforma->guindastes->ativosMax = ativosMax;
+    return true;
+}
+bool atracarNavio(Lote *lote, int indice, int capacidade)
+{
+    Plataforma *plataforma = plataformaDoLote(lote, indice);
+    if (plataforma == NULL || capacidade < 0)
+    {
+        return false;
+    }
+    return atualizarNavio(plataforma->guindastes, capacidade);
+}
+bool alterarEmergencia(Lote *lote, int indice, bool emergencia)
+{
+    Plataforma *plataforma = plataformaDoLote(lote, indice);
+    if (plataforma == NULL)
+    {
+        return false;
+    }
+    if (emergencia)
+    {
+        emergenciaDoBombeamento(plataforma->bombas);
+    }
+    else
+    {
+        normalizacaoDoBombeamento(plataforma->bombas);
+    }
+    return true;
+}
+
+/* Remove o lote, e todas as suas plataformas, da memória. */
+void removerLote(Lote *lote)
+{
+    if (lote != NULL)
+    {
+        // O próprio lote fica na arena.
+        removerArena(lote->arena);
+    }
+}
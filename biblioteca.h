@@ -0,0 +1,102 @@
+#ifndef _BIBLIOTECA
+#define _BIBLIOTECA
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "estimativa.h"
+#include "plataforma.h"
+
+/** Interface da biblioteca libplataforma.so, usada por programas
+externos (por exemplo, o módulo plataforma.py) para simular uma ou
+várias plataformas sem abrir o programa principal. As listas de estados
+e de custos são acessadas diretamente, sem cópias. */
+
+/** Lote de plataformas criadas juntas, em uma única arena. Uma
+plataforma isolada é um lote de tamanho 1. */
+typedef struct {
+    // Número de plataformas do lote.
+    int quantidade;
+    // Arena onde ficam as plataformas, suas bombas e guindastes e a
+    // lista de custos.
+    Arena *arena;
+    // Vetor de plataformas do lote.
+    Plataforma *plataformas;
+    // Custo acumulado de cada plataforma, em reais.
+    double *custos;
+} Lote;
+
+/** Resumo do estado de uma plataforma. Tem um leiaute fixo, para que
+programas externos possam lê-lo sem conhecer as outras estruturas. O
+horário é derivado do relógio, que fica no fim. */
+typedef struct {
+    int hora;
+    int minuto;
+    int segundo;
+    int bombasAtivas;
+    int bombasTotais;
+    int guindastesAtivos;
+    int guindastesTotais;
+    int guindastesAtivosMax;
+    int carregando;
+    int estadoDoNavio;
+    int barrisPreparados;
+    double custo;
+    int64_t relogio;
+} Consulta;
+
+/** Protótipos das funções públicas. */
+
+/* Cria um lote de plataformas iguais, com o número de séries de bombas
+e de guindastes especificado, todas com o relógio no início e com um navio da
+capacidade especificada (0 para nenhum navio). Retorna um apontador
+nulo se não houver memória suficiente. */
+Lote *CriarLote(int quantidade, int num_bombas, int num_guindastes,
+                int capacidadeDoNavio);
+
+/* Dá uma quantidade de passos em todas as plataformas do lote, em
+paralelo. Retorna o custo desses passos, somado entre as
+plataformas. */
+double passosDoLote(Lote *lote, int64_t passos);
+
+/* Dá uma quantidade de passos em uma plataforma do lote. Retorna o
+custo desses passos, ou -1 se o índice não existir. */
+double passosDaPlataforma(Lote *lote, int indice, int64_t passos);
+
+/* Avança uma plataforma do lote até o navio atracado ficar cheio.
+Retorna o custo desses passos, ou -1 se o índice não existir. */
+double passosAteNavioCheio(Lote *lote, int indice);
+
+/* Estima quando o navio atracado em uma plataforma do lote ficará
+cheio, e o custo até lá, sem avançar a simulação. Retorna false se o
+índice não existir ou se o navio não ficar cheio. Usa o cache
+indicado pela variável de ambiente PLATAFORMA_CACHE, se houver. */
+bool estimarNavioDoLote(Lote *lote, int indice,
+                        EstimativaDoNavio *estimativa);
+
+/* Coloca o resumo do estado de uma plataforma do lote no endereço de
+memória especificado. Retorna false se o índice não existir. */
+bool consultarPlataforma(Lote *lote, int indice, Consulta *consulta);
+
+/* Retornam as listas de estados de uma plataforma do lote e a lista de
+custos de todas as plataformas, sem cópia. As listas continuam válidas
+até o lote ser removido. Retornam um apontador nulo se o índice não
+existir. */
+int *progressosDosGuindastes(Lote *lote, int indice);
+bool *estadosDosGuindastes(Lote *lote, int indice);
+bool *estadosDasBombas(Lote *lote, int indice);
+double *custosDoLote(Lote *lote);
+
+/* Alteram o estado de uma plataforma do lote, como os comandos B, G, n
+e e/E do modo interativo. Retornam false se o índice não existir ou se
+a alteração não for possível. */
+bool alterarBombasDaPlataforma(Lote *lote, int indice, int ativas);
+bool alterarGuindastesDaPlataforma(Lote *lote, int indice, int ativosMax);
+bool atracarNavio(Lote *lote, int indice, int capacidade);
+bool alterarEmergencia(Lote *lote, int indice, bool emergencia);
+
+/* Remove o lote, e todas as suas plataformas, da memória. */
+void removerLote(Lote *lote);
+
+#endif // _BIBLIOTECA
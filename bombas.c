@@ -10,11 +10,45 @@
  */
 
 #include <stdbool.h>
+#ifndef CONTROLADOR_EMBARCADO
 #include <stdlib.h>
 #include <stdio.h>
+#endif
 
 #include "bombas.h"
 
+/* Inicializa um sistema de bombeamento em um bloco de memória com o
+tamanho dado por tamanhoDasBombas. A lista de estados fica no mesmo
+bloco, logo após a estrutura. Função local. */
+static Bombas *inicializarBombas(void *memoria, int num_bombas)
+{
+    Bombas *bombas = memoria;
+    bombas->estados = (bool *)((unsigned char *)memoria
+                               + ALINHAR_NA_ARENA(sizeof(Bombas)));
+    for (int i = 0; i < num_bombas; i++)
+    {
+        bombas->estados[i] = true;
+    }
+    // Inicializa o restante das variáveis.
+    bombas->totais = num_bombas;
+    bombas->ativas = num_bombas;
+    bombas->luzAmarela = true;
+    bombas->luzVermelha = false;
+    bombas->cortadas = 0;
+    bombas->rotacao = 0;
+    bombas->passosNoRodizio = 0;
+    return bombas;
+}
+
+/* Retorna o tamanho, em bytes, de um sistema de bombeamento com o
+número de bombas especificado, incluindo a lista de estados. */
+size_t tamanhoDasBombas(int num_bombas)
+{
+    return ALINHAR_NA_ARENA(sizeof(Bombas))
+           + ALINHAR_NA_ARENA(num_bombas * sizeof(bool));
+}
+
+#ifndef CONTROLADOR_EMBARCADO
 /* Cria e inicializa um sistema de bombeamento. No início, todas as
 bombas estão ativas. */
 Bombas *CriarBombas(int num_bombas)
@@ -25,32 +59,35 @@ Bombas *CriarBombas(int num_bombas)
     {
         return NULL;
     }
-    // Tenta reservar espaço para um sistema de bombeamento. Se isso
-    // falhar, retorn um apontador nulo.
-    Bombas *bombas = malloc(sizeof(Bombas));
-    if (bombas == NULL)
+    // Tenta reservar espaço para um sistema de bombeamento e sua
+    // lista de estados, de uma só vez. Se isso falhar, retorna um
+    // apontador nulo.
+    void *memoria = malloc(tamanhoDasBombas(num_bombas));
+    if (memoria == NULL)
     {
         return NULL;
     }
-    // Tenta criar uma lista para guardar os estados. Se isso falhar,
-    // retorna um apontador nulo.
-    bombas->estados = malloc(num_bombas * sizeof(bool));
-    if (bombas->estados == NULL)
+    return inicializarBombas(memoria, num_bombas);
+}
+#endif
+
+/* Funciona como CriarBombas, mas reserva o sistema de bombeamento em
+uma arena. Retorna um apontador nulo se não houver espaço na arena. */
+Bombas *CriarBombasNaArena(Arena *arena, int num_bombas)
+{
+    if (num_bombas < 1)
     {
         return NULL;
     }
-    for (int i = 0; i < num_bombas; i++)
+    void *memoria = reservarNaArena(arena, tamanhoDasBombas(num_bombas));
+    if (memoria == NULL)
     {
-        bombas->estados[i] = true;
+        return NULL;
     }
-    // Inicializa o restante das variáveis.
-    bombas->totais = num_bombas;
-    bombas->ativas = num_bombas;
-    bombas->luzAmarela = true;
-    bombas->luzVermelha = false;
-    return bombas;
+    return inicializarBombas(memoria, num_bombas);
 }
 
+#ifndef CONTROLADOR_EMBARCADO
 /* Mostra ATIVA se o estado for verdadeiro, INATIVA se for
 falso. Utilizado por estadoDoBombeamento. Função local. */
 static void mostrarEstadoDaBomba(bool estado)
@@ -83,6 +120,7 @@ void estadoDoBombeamento(Bombas *bombas)
     printf("Luz vermelha: ");
     mostrarEstadoDaBomba(bombas->luzVermelha);
 }
+#endif
 
 /* Altera o número de bombas ativas de um sistema de bombeamento,
 atualizando ao mesmo tempo o estado de cada série de bombas e da luz
@@ -96,6 +134,8 @@ void alterarBombasAtivas(Bombas *bombas, int ativas)
         return;
     }
     bombas->ativas = ativas;
+    bombas->cortadas = 0;
+    bombas->passosNoRodizio = 0;
     for (int i = 0; i < bombas->totais; i++)
     {
         bombas->estados[i] = i < ativas;
@@ -103,6 +143,70 @@ void alterarBombasAtivas(Bombas *bombas, int ativas)
     bombas->luzAmarela = ativas;
 }
 
+/* Desliga temporariamente uma quantidade de séries de bombas para
+reduzir a demanda de energia, religando antes as séries desligadas
+no corte anterior. Se rotacionar for true, cada novo corte começa
+pela série seguinte à do corte anterior, e um corte que continua
+passa para as séries seguintes a cada PASSOS_DO_RODIZIO chamadas;
+nesse caso, deve ser chamada a cada passo enquanto o corte durar. */
+void cortarBombas(Bombas *bombas, int cortadas, bool rotacionar)
+{
+    // Bloqueia a alteração das bombas caso o modo de emergência
+    // esteja ativado.
+    if (bombas->luzVermelha)
+    {
+        return;
+    }
+    int desejadas = bombas->ativas + bombas->cortadas;
+    if (cortadas > desejadas)
+    {
+        cortadas = desejadas;
+    }
+    // Um novo corte, depois de um período sem cortes, ou um corte que
+    // já desligou as mesmas séries por PASSOS_DO_RODIZIO passos, passa
+    // a desligar as séries seguintes.
+    bool rodar = false;
+    if (rotacionar && cortadas > 0)
+    {
+        rodar = bombas->cortadas == 0
+                || ++bombas->passosNoRodizio >= PASSOS_DO_RODIZIO;
+    }
+    if (rodar || cortadas == 0)
+    {
+        bombas->passosNoRodizio = 0;
+    }
+    // Se nada mudou, as séries ligadas continuam as mesmas.
+    if (!rodar && cortadas == bombas->cortadas)
+    {
+        return;
+    }
+    if (rodar)
+    {
+        bombas->rotacao = (bombas->rotacao + cortadas) % bombas->totais;
+    }
+    bombas->cortadas = cortadas;
+    bombas->ativas = desejadas - cortadas;
+    if (!rotacionar)
+    {
+        for (int i = 0; i < bombas->totais; i++)
+        {
+            bombas->estados[i] = i < bombas->ativas;
+        }
+    }
+    else
+    {
+        // As séries desligadas começam na posição da rotação, e as
+        // ativas vêm logo depois delas, em ordem circular.
+        for (int i = 0; i < bombas->totais; i++)
+        {
+            int posicao = (i - bombas->rotacao - cortadas
+                           + 2 * bombas->totais) % bombas->totais;
+            bombas->estados[i] = posicao < bombas->ativas;
+        }
+    }
+    bombas->luzAmarela = bombas->ativas;
+}
+
 /* Ativa o estado de emergência das bombas. */
 void emergenciaDoBombeamento(Bombas *bombas)
 {
@@ -116,12 +220,12 @@ void normalizacaoDoBombeamento(Bombas *bombas)
     bombas->luzVermelha = false;
 }
 
-/* Remove o sistema de bombeamento da memória. */
+#ifndef CONTROLADOR_EMBARCADO
+/* Remove o sistema de bombeamento da memória. Não deve ser usada com
+sistemas criados em uma arena. */
 void removerBombeamento(Bombas *bombas)
 {
-    if (bombas != NULL)
-    {
-        free(bombas->estados);
-    }
+    // A lista de estados faz parte do mesmo bloco de memória.
     free(bombas);
 }
+#endif
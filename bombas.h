@@ -2,12 +2,19 @@
 #define _BOMBAS
 
 #include <stdbool.h>
+#include <stddef.h>
+
+#include "arena.h"
 
 /* Número de séries de bombas, definido pelo desafio. */
 #define NUM_BOMBAS 25
 /* Potência das séries de bombas, definida pelo desafio, em kW por
 série de bombas ativa. */
 #define P_BOMBA 40
+/* Número de passos, em segundos, que as mesmas séries de bombas ficam
+desligadas durante um corte de carga com rodízio, antes que o corte
+passe para as séries seguintes. Definido pela equipe. */
+#define PASSOS_DO_RODIZIO 900
 
 /** Representação programática de um sistema de bombeamento. Em um
 sistema real, os valores das variáveis estados (das bombas), luzAmarela
@@ -21,6 +28,15 @@ typedef struct {
     // Nos itens seguintes, true = ativa, false = inativa.
     // Lista que representa o estado de cada bomba.
     bool *estados;
+    // Número de séries desligadas temporariamente pelo corte de
+    // carga, que são religadas quando a energia permite.
+    int cortadas;
+    // Primeira série desligada no último corte de carga. Avança a cada
+    // novo corte, e a cada PASSOS_DO_RODIZIO passos enquanto o corte
+    // durar, para que as mesmas séries não fiquem sempre desligadas.
+    int rotacao;
+    // Número de passos do corte atual desde que a rotação avançou.
+    int passosNoRodizio;
     // Ativada quando ativas > 0.
     bool luzAmarela;
     // Ativada quando o botão é pressionado.
@@ -30,26 +46,49 @@ typedef struct {
 /** Protótipos das funções públicas, utilizadas pelo controlador
 principal. */
 
+#ifndef CONTROLADOR_EMBARCADO
 /* Cria e inicializa um sistema de bombeamento. No início, todas as
 bombas estão ativas. */
 Bombas *CriarBombas(int num_bombas);
+#endif
+
+/* Funciona como CriarBombas, mas reserva o sistema de bombeamento em
+uma arena. Retorna um apontador nulo se não houver espaço na arena. */
+Bombas *CriarBombasNaArena(Arena *arena, int num_bombas);
 
+/* Retorna o tamanho, em bytes, de um sistema de bombeamento com o
+número de bombas especificado, incluindo a lista de estados. */
+size_t tamanhoDasBombas(int num_bombas);
+
+#ifndef CONTROLADOR_EMBARCADO
 /* Mostra o estado de todos os componentes de um sistema de
 bombeamento no terminal. */
 void estadoDoBombeamento(Bombas *bombas);
+#endif
 
 /* Altera o número de bombas ativas de um sistema de bombeamento,
 atualizando ao mesmo tempo o estado de cada série de bombas e da luz
 indicadora. */
 void alterarBombasAtivas(Bombas *bombas, int ativas);
 
+/* Desliga temporariamente uma quantidade de séries de bombas para
+reduzir a demanda de energia, religando antes as séries desligadas
+no corte anterior. Se rotacionar for true, cada novo corte começa
+pela série seguinte à do corte anterior, e um corte que continua
+passa para as séries seguintes a cada PASSOS_DO_RODIZIO chamadas;
+nesse caso, deve ser chamada a cada passo enquanto o corte durar. */
+void cortarBombas(Bombas *bombas, int cortadas, bool rotacionar);
+
 /* Ativa o estado de emergência das bombas. */
 void emergenciaDoBombeamento(Bombas *bombas);
 
 /* Desativa o estado de emergência das bombas. */
 void normalizacaoDoBombeamento(Bombas *bombas);
 
-/* Remove o sistema de bombeamento da memória. */
+#ifndef CONTROLADOR_EMBARCADO
+/* Remove o sistema de bombeamento da memória. Não deve ser usada com
+sistemas criados em uma arena. */
 void removerBombeamento(Bombas *bombas);
+#endif
 
 #endif // _BOMBAS
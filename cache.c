@@ -0,0 +1,622 @@
+/** Cache de resultados de simulações, em um arquivo mapeado na
+ *  memória. O arquivo começa por um cabeçalho, seguido por um índice
+ *  com endereçamento aberto (sondagem linear) e pelos resultados, um
+ *  após o outro. Uma posição do índice só passa a fazer parte do cache
+ *  quando a posição do seu resultado é escrita, depois de o resultado
+ *  ter sido copiado para o arquivo; assim, uma consulta nunca lê um
+ *  resultado incompleto. Quando três quartos do índice estão ocupados,
+ *  um índice com o dobro de posições é montado no fim do arquivo, e só
+ *  então o cabeçalho passa a apontar para ele; o índice antigo continua
+ *  válido para quem ainda o estiver lendo. Os processos que guardam
+ *  resultados no mesmo arquivo se revezam com flock. O arquivo nunca
+ *  diminui: um cache de outra versão é trocado por um arquivo novo,
+ *  e quem ainda tiver o antigo mapeado continua lendo-o.
+ */
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "cache.h"
+#include "energia.h"
+
+/* Identificação dos arquivos de cache, e de sua versão. */
+#define ASSINATURA_DO_CACHE "PLTCACH2"
+/* Espaço inicial para os resultados, em bytes. Dobra sempre que não
+houver espaço para um novo resultado. */
+#define ESPACO_INICIAL_DO_CACHE (64 * 1024)
+/* Alinhamento dos resultados no arquivo, em bytes. */
+#define ALINHAMENTO_DO_CACHE 8
+/* Sufixo do arquivo temporário em que um cache vazio é montado antes
+de substituir o arquivo do cache, completado por mkstemp. */
+#define SUFIXO_TEMPORARIO ".XXXXXX"
+
+/** Cabeçalho do arquivo do cache. */
+typedef struct {
+    char assinatura[8];
+    // Versão do simulador que produziu os resultados.
+    uint64_t versao;
+    // Bytes usados no arquivo, incluindo o cabeçalho e os índices.
+    uint64_t usados;
+    // Posição do índice atual no arquivo. Muda quando o índice cresce.
+    uint64_t indice;
+    // Posições ocupadas do índice atual.
+    uint64_t ocupadas;
+} CabecalhoDoCache;
+
+/** Posição do índice do cache. */
+typedef struct {
+    uint64_t chave;
+    // Posição do resultado no arquivo, ou 0 se a posição do índice
+    // estiver livre.
+    uint64_t posicao;
+    // Tamanho do resultado, em bytes.
+    uint64_t tamanho;
+} EntradaDoCache;
+
+/** Índice do cache: o número de posições, seguido pelas posições. */
+typedef struct {
+    uint64_t posicoes;
+    EntradaDoCache entradas[];
+} IndiceDoCache;
+
+/* Cache do ambiente, aberto por cacheDoAmbiente. */
+static Cache *cacheAberto = NULL;
+/* true se a variável de ambiente já foi consultada. */
+static bool ambienteConsultado = false;
+
+/* Arredonda um tamanho para o alinhamento dos resultados. Função
+local. */
+static size_t alinhar(size_t bytes)
+{
+    return (bytes + ALINHAMENTO_DO_CACHE - 1)
+           & ~(size_t)(ALINHAMENTO_DO_CACHE - 1);
+}
+
+/* Retorna o cabeçalho do cache. Função local. */
+static CabecalhoDoCache *cabecalho(Cache *cache)
+{
+    return (CabecalhoDoCache *)cache->memoria;
+}
+
+/* Retorna o tamanho, em bytes, de um índice com o número de posições
+especificado. Função local. */
+static size_t tamanhoDoIndice(uint64_t posicoes)
+{
+    return sizeof(IndiceDoCache) + posicoes * sizeof(EntradaDoCache);
+}
+
+/* Retorna o índice que está na posição especificada do arquivo.
+Função local. */
+static IndiceDoCache *indiceNaPosicao(Cache *cache, uint64_t posicao)
+{
+    return (IndiceDoCache *)(cache->memoria + posicao);
+}
+
+/* Retorna a posição do índice em que está o resultado com a chave e o
+tamanho especificados ou, se ele não estiver no índice, a posição
+livre em que ele deve ser guardado. Função local. */
+static uint64_t procurarNoIndice(IndiceDoCache *indice, uint64_t chave,
+                                 uint64_t tamanho)
+{
+    uint64_t i = chave % indice->posicoes;
+    // O índice nunca fica mais que 3/4 ocupado, então sempre há uma
+    // posição livre.
+    while (__atomic_load_n(&indice->entradas[i].posicao,
+                           __ATOMIC_ACQUIRE) != 0
+           && (indice->entradas[i].chave != chave
+               || indice->entradas[i].tamanho != tamanho))
+    {
+        i = (i + 1) % indice->posicoes;
+    }
+    return i;
+}
+
+/* Acrescenta um número inteiro a um hash FNV-1a. Função local. */
+static uint64_t hashDoInteiro(uint64_t hash, int64_t valor)
+{
+    return hashFNV(hash, &valor, sizeof(valor));
+}
+
+/* Mapeia o arquivo do cache com a capacidade especificada, que não
+pode ser maior que o arquivo. O mapeamento anterior só é desfeito
+depois que o novo dá certo; se não der, ele continua valendo e a
+função retorna false. Função local. */
+static bool mapearCache(Cache *cache, size_t capacidade)
+{
+    void *memoria = mmap(NULL, capacidade, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, cache->arquivo, 0);
+    if (memoria == MAP_FAILED)
+    {
+        return false;
+    }
+    if (cache->memoria != NULL)
+    {
+        munmap(cache->memoria, cache->capacidade);
+    }
+    cache->memoria = memoria;
+    cache->capacidade = capacidade;
+    return true;
+}
+
+/* Mapeia novamente o arquivo do cache se outro processo o aumentou.
+Retorna false se não for possível. Função local. */
+static bool acompanharArquivo(Cache *cache)
+{
+    struct stat informacoes;
+    if (fstat(cache->arquivo, &informacoes) != 0)
+    {
+        return false;
+    }
+    if ((size_t)informacoes.st_size <= cache->capacidade)
+    {
+        return true;
+    }
+    return mapearCache(cache, informacoes.st_size);
+}
+
+/* Aumenta o arquivo do cache, dobrando sua capacidade, até que ele
+tenha pelo menos o número de bytes especificado, e o mapeia
+novamente. Deve ser chamada com o arquivo travado e acompanhado.
+Retorna false se não for possível; nesse caso, o arquivo e o
+mapeamento anteriores continuam valendo. Função local. */
+static bool reservarNoArquivo(Cache *cache, size_t necessario)
+{
+    size_t capacidade = cache->capacidade;
+    while (capacidade < necessario)
+    {
+        capacidade *= 2;
+    }
+    if (capacidade == cache->capacidade
+        || (ftruncate(cache->arquivo, capacidade) == 0
+            && mapearCache(cache, capacidade)))
+    {
+        return true;
+    }
+    // Devolve o arquivo ao tamanho mapeado, para que nenhum processo
+    // tente mapear o espaço que não pôde ser usado.
+    ftruncate(cache->arquivo, cache->capacidade);
+    return false;
+}
+
+/* Monta, no fim do arquivo, um índice com o dobro de posições do
+atual, com os mesmos resultados, e passa a usá-lo. Retorna false se
+não houver espaço. Função local. */
+static bool crescerIndice(Cache *cache)
+{
+    uint64_t antigo = cabecalho(cache)->indice;
+    uint64_t posicoes = indiceNaPosicao(cache, antigo)->posicoes * 2;
+    uint64_t posicao = cabecalho(cache)->usados;
+    if (!reservarNoArquivo(cache, posicao + tamanhoDoIndice(posicoes)))
+    {
+        return false;
+    }
+    IndiceDoCache *velho = indiceNaPosicao(cache, antigo);
+    IndiceDoCache *novo = indiceNaPosicao(cache, posicao);
+    memset(novo, 0, tamanhoDoIndice(posicoes));
+    novo->posicoes = posicoes;
+    for (uint64_t i = 0; i < velho->posicoes; i++)
+    {
+        EntradaDoCache *entrada = &velho->entradas[i];
+        if (entrada->posicao != 0)
+        {
+            novo->entradas[procurarNoIndice(novo, entrada->chave,
+                                            entrada->tamanho)] = *entrada;
+        }
+    }
+    // O novo índice deve estar completo na memória antes de o
+    // cabeçalho apontar para ele.
+    CabecalhoDoCache *cab = cabecalho(cache);
+    cab->usados = posicao + tamanhoDoIndice(posicoes);
+    __atomic_store_n(&cab->indice, posicao, __ATOMIC_RELEASE);
+    return true;
+}
+
+/* Abre o arquivo do cache, criando-o se ele não existir, e o trava.
+Outro processo pode ter posto um arquivo novo no lugar enquanto este
+esperava a trava; nesse caso, abre o novo. Retorna o descritor do
+arquivo, ou -1 se não for possível. Função local. */
+static int abrirArquivoTravado(const char *caminho)
+{
+    while (true)
+    {
+        int arquivo = open(caminho, O_RDWR | O_CREAT, 0644);
+        if (arquivo < 0)
+        {
+            return -1;
+        }
+        struct stat aberto, atual;
+        if (flock(arquivo, LOCK_EX) != 0 || fstat(arquivo, &aberto) != 0)
+        {
+            close(arquivo);
+            return -1;
+        }
+        if (stat(caminho, &atual) == 0 && atual.st_dev == aberto.st_dev
+            && atual.st_ino == aberto.st_ino)
+        {
+            return arquivo;
+        }
+        close(arquivo);
+    }
+}
+
+/* Cria um arquivo de cache vazio, para a versão atual do simulador, e
+o põe no lugar do arquivo do cache com rename. O arquivo antigo não é
+alterado: outros processos podem tê-lo mapeado, e diminuí-lo faria com
+que suas leituras recebessem SIGBUS. O novo arquivo, já travado, passa
+a ser o do cache. Retorna false se não for possível; nesse caso, o
+cache continua com o arquivo antigo. Função local. */
+static bool esvaziarCache(Cache *cache, const char *caminho)
+{
+    size_t inicio = sizeof(CabecalhoDoCache)
+                    + tamanhoDoIndice(POSICOES_DO_CACHE);
+    size_t capacidade = inicio + ESPACO_INICIAL_DO_CACHE;
+    size_t tamanho = strlen(caminho);
+    char *temporario = malloc(tamanho + sizeof(SUFIXO_TEMPORARIO));
+    if (temporario == NULL)
+    {
+        return false;
+    }
+    memcpy(temporario, caminho, tamanho);
+    memcpy(temporario + tamanho, SUFIXO_TEMPORARIO,
+           sizeof(SUFIXO_TEMPORARIO));
+    int arquivo = mkstemp(temporario);
+    if (arquivo < 0)
+    {
+        free(temporario);
+        return false;
+    }
+    // O novo arquivo é travado antes do rename, para que quem o abrir
+    // espere o cabeçalho ser escrito. O índice começa zerado.
+    void *memoria = MAP_FAILED;
+    if (flock(arquivo, LOCK_EX) == 0 && fchmod(arquivo, 0644) == 0
+        && ftruncate(arquivo, capacidade) == 0)
+    {
+        memoria = mmap(NULL, capacidade, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, arquivo, 0);
+    }
+    if (memoria != MAP_FAILED)
+    {
+        CabecalhoDoCache *cab = memoria;
+        memcpy(cab->assinatura, ASSINATURA_DO_CACHE, 8);
+        cab->versao = versaoDoSimulador();
+        cab->usados = inicio;
+        cab->indice = sizeof(CabecalhoDoCache);
+        cab->ocupadas = 0;
+        ((IndiceDoCache *)(cab + 1))->posicoes = POSICOES_DO_CACHE;
+        if (rename(temporario, caminho) != 0)
+        {
+            munmap(memoria, capacidade);
+            memoria = MAP_FAILED;
+        }
+    }
+    if (memoria == MAP_FAILED)
+    {
+        close(arquivo);
+        unlink(temporario);
+        free(temporario);
+        return false;
+    }
+    free(temporario);
+    // Fechar o arquivo antigo também desfaz a sua trava.
+    if (cache->memoria != NULL)
+    {
+        munmap(cache->memoria, cache->capacidade);
+    }
+    close(cache->arquivo);
+    cache->arquivo = arquivo;
+    cache->memoria = memoria;
+    cache->capacidade = capacidade;
+    return true;
+}
+
+/* Fecha o cache do ambiente ao fim do programa. Função local. */
+static void fecharCacheDoAmbiente(void)
+{
+    removerCache(cacheAberto);
+    cacheAberto = NULL;
+}
+
+/* Acrescenta bytes a um hash FNV-1a de 64 bits, começado em
+FNV_INICIAL, e retorna o novo hash. */
+uint64_t hashFNV(uint64_t hash, const void *dados, size_t tamanho)
+{
+    const unsigned char *bytes = dados;
+    for (size_t i = 0; i < tamanho; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/* Retorna o hash da versão do simulador: do seu código-fonte (definido
+por HASH_DO_CODIGO na compilação) e das constantes do desafio. */
+uint64_t versaoDoSimulador(void)
+{
+#ifdef HASH_DO_CODIGO
+    uint64_t codigo = HASH_DO_CODIGO;
+    uint64_t hash = hashFNV(FNV_INICIAL, &codigo, sizeof(codigo));
+#else
+    // Sem o hash do código-fonte, cada compilação é uma nova versão.
+    const char codigo[] = __DATE__ " " __TIME__;
+    uint64_t hash = hashFNV(FNV_INICIAL, codigo, sizeof(codigo));
+#endif
+    // As constantes também fazem parte da versão, para que o cache não
+    // dependa apenas do hash do código.
+    const double constantes[] = {
+        NUM_TURBINAS, P_AUXILIAR, P_TERMELETRICA, C_TERMELETRICA,
+        E_INVERSORES, P_BOMBA, P_GUINDASTE, TEMPO_DE_COLETA,
+        TEMPO_DE_CARREGAMENTO, CAPACIDADE_DA_PREPARACAO, TEMPO_DE_TROCA
+    };
+    return hashFNV(hash, constantes, sizeof(constantes));
+}
+
+/* Retorna a chave do resultado de um comando, com seus argumentos
+numéricos, executado a partir do estado especificado de uma
+plataforma. */
+uint64_t chaveDoCenario(const char *comando, const Bombas *bombas,
+                        const Guindastes *guindastes, Relogio relogio,
+                        const int64_t *argumentos, int n)
+{
+    uint64_t hash = hashDoInteiro(FNV_INICIAL, versaoDoSimulador());
+    // O comando inclui o caractere nulo, para que "ab", 1 e "a", 1
+    // não se confundam.
+    hash = hashFNV(hash, comando, strlen(comando) + 1);
+    hash = hashDoInteiro(hash, n);
+    for (int i = 0; i < n; i++)
+    {
+        hash = hashDoInteiro(hash, argumentos[i]);
+    }
+    // Mesmo estado comparado por plataformasIguais.
+    hash = hashDoInteiro(hash, relogio);
+    hash = hashDoInteiro(hash, bombas->totais);
+    hash = hashDoInteiro(hash, bombas->ativas);
+    hash = hashDoInteiro(hash, bombas->luzAmarela);
+    hash = hashDoInteiro(hash, bombas->luzVermelha);
+    hash = hashDoInteiro(hash, bombas->cortadas);
+    hash = hashDoInteiro(hash, bombas->rotacao);
+    hash = hashDoInteiro(hash, bombas->passosNoRodizio);
+    hash = hashFNV(hash, bombas->estados, bombas->totais * sizeof(bool));
+    hash = hashDoInteiro(hash, guindastes->totais);
+    hash = hashDoInteiro(hash, guindastes->ativos);
+    hash = hashDoInteiro(hash, guindastes->ativosMax);
+    hash = hashDoInteiro(hash, guindastes->limiteDeEnergia);
+    hash = hashDoInteiro(hash, guindastes->carregando);
+    hash = hashDoInteiro(hash, guindastes->estadoDoNavio);
+    hash = hashDoInteiro(hash, guindastes->preparacao);
+    hash = hashDoInteiro(hash, guindastes->barrisPreparados);
+    hash = hashFNV(hash, guindastes->progressos,
+                   guindastes->totais * sizeof(int));
+    return hashFNV(hash, guindastes->estados,
+                   guindastes->totais * sizeof(bool));
+}
+
+/* Abre o cache no arquivo especificado, criando-o se ele não existir,
+e o substitui por um cache vazio se ele for de outra versão do
+simulador. Retorna um apontador nulo se o arquivo não puder ser aberto
+ou mapeado. */
+Cache *AbrirCache(const char *caminho)
+{
+    Cache *cache = malloc(sizeof(Cache));
+    if (cache == NULL)
+    {
+        return NULL;
+    }
+    cache->arquivo = abrirArquivoTravado(caminho);
+    cache->memoria = NULL;
+    cache->capacidade = 0;
+    struct stat informacoes;
+    if (cache->arquivo < 0)
+    {
+        removerCache(cache);
+        return NULL;
+    }
+    bool valido = fstat(cache->arquivo, &informacoes) == 0
+                  && informacoes.st_size >= (off_t)sizeof(CabecalhoDoCache)
+                  && mapearCache(cache, informacoes.st_size);
+    if (valido)
+    {
+        // Um cache de outra versão do simulador, ou corrompido, é
+        // esvaziado.
+        CabecalhoDoCache *cab = cabecalho(cache);
+        valido = !memcmp(cab->assinatura, ASSINATURA_DO_CACHE, 8)
+                 && cab->versao == versaoDoSimulador()
+                 && cab->usados <= cache->capacidade
+                 && cab->indice >= sizeof(CabecalhoDoCache)
+                 && cab->indice + sizeof(IndiceDoCache) <= cab->usados;
+        if (valido)
+        {
+            uint64_t posicoes = indiceNaPosicao(cache, cab->indice)->posicoes;
+            valido = posicoes >= POSICOES_DO_CACHE
+                     && posicoes <= cab->usados / sizeof(EntradaDoCache)
+                     && cab->indice + tamanhoDoIndice(posicoes)
+                        <= cab->usados;
+        }
+    }
+    if (!valido && !esvaziarCache(cache, caminho))
+    {
+        removerCache(cache);
+        return NULL;
+    }
+    flock(cache->arquivo, LOCK_UN);
+    return cache;
+}
+
+/* Retorna o cache do arquivo indicado pela variável de ambiente
+VARIAVEL_DO_CACHE, aberto na primeira chamada e fechado ao fim do
+programa, ou um apontador nulo se ela não estiver definida ou se o
+arquivo não puder ser aberto. */
+Cache *cacheDoAmbiente(void)
+{
+    if (!ambienteConsultado)
+    {
+        ambienteConsultado = true;
+        const char *caminho = getenv(VARIAVEL_DO_CACHE);
+        if (caminho != NULL && *caminho != '\0')
+        {
+            cacheAberto = AbrirCache(caminho);
+        }
+        if (cacheAberto != NULL)
+        {
+            atexit(fecharCacheDoAmbiente);
+        }
+    }
+    return cacheAberto;
+}
+
+/* Copia o resultado guardado com a chave especificada para o endereço
+de memória indicado. Retorna false se o cache for nulo ou se não
+houver um resultado com a chave e o tamanho especificados. */
+bool consultarCache(Cache *cache, uint64_t chave, void *resultado,
+                    size_t tamanho)
+{
+    if (cache == NULL)
+    {
+        return false;
+    }
+    // O índice, ou o resultado, pode ter sido guardado por outro
+    // processo, além do fim da região mapeada.
+    uint64_t posicaoDoIndice = __atomic_load_n(&cabecalho(cache)->indice,
+                                               __ATOMIC_ACQUIRE);
+    if (posicaoDoIndice + sizeof(IndiceDoCache) > cache->capacidade
+        && (!acompanharArquivo(cache)
+            || posicaoDoIndice + sizeof(IndiceDoCache) > cache->capacidade))
+    {
+        return false;
+    }
+    uint64_t fimDoIndice = posicaoDoIndice + tamanhoDoIndice(
+        indiceNaPosicao(cache, posicaoDoIndice)->posicoes);
+    if (fimDoIndice > cache->capacidade
+        && (!acompanharArquivo(cache) || fimDoIndice > cache->capacidade))
+    {
+        return false;
+    }
+    IndiceDoCache *indice = indiceNaPosicao(cache, posicaoDoIndice);
+    EntradaDoCache *entrada =
+        &indice->entradas[procurarNoIndice(indice, chave, tamanho)];
+    uint64_t posicao = __atomic_load_n(&entrada->posicao,
+                                       __ATOMIC_ACQUIRE);
+    if (posicao == 0)
+    {
+        return false;
+    }
+    if (posicao + tamanho > cache->capacidade
+        && (!acompanharArquivo(cache)
+            || posicao + tamanho > cache->capacidade))
+    {
+        return false;
+    }
+    memcpy(resultado, cache->memoria + posicao, tamanho);
+    return true;
+}
+
+/* Guarda um resultado com a chave especificada. Retorna false se o
+cache for nulo ou se o resultado não puder ser gravado. */
+bool guardarNoCache(Cache *cache, uint64_t chave, const void *resultado,
+                    size_t tamanho)
+{
+    if (cache == NULL || flock(cache->arquivo, LOCK_EX) != 0)
+    {
+        return false;
+    }
+    if (!acompanharArquivo(cache))
+    {
+        flock(cache->arquivo, LOCK_UN);
+        return false;
+    }
+    // Procura a posição livre, ou a do mesmo resultado, guardado por
+    // outro processo.
+    CabecalhoDoCache *cab = cabecalho(cache);
+    IndiceDoCache *indice = indiceNaPosicao(cache, cab->indice);
+    uint64_t i = procurarNoIndice(indice, chave, tamanho);
+    if (indice->entradas[i].posicao != 0)
+    {
+        flock(cache->arquivo, LOCK_UN);
+        return true;
+    }
+    // O índice cresce antes de passar de 3/4 ocupado.
+    if ((cab->ocupadas + 1) * 4 > indice->posicoes * 3)
+    {
+        if (!crescerIndice(cache))
+        {
+            flock(cache->arquivo, LOCK_UN);
+            return false;
+        }
+        cab = cabecalho(cache);
+        indice = indiceNaPosicao(cache, cab->indice);
+        i = procurarNoIndice(indice, chave, tamanho);
+    }
+    size_t posicao = cab->usados;
+    size_t necessario = posicao + alinhar(tamanho);
+    bool guardado = reservarNoArquivo(cache, necessario);
+    if (guardado)
+    {
+        // O cabeçalho e o índice mudam de endereço se o arquivo for
+        // mapeado novamente.
+        cab = cabecalho(cache);
+        EntradaDoCache *entrada =
+            &indiceNaPosicao(cache, cab->indice)->entradas[i];
+        memcpy(cache->memoria + posicao, resultado, tamanho);
+        entrada->chave = chave;
+        entrada->tamanho = tamanho;
+        // O resultado deve estar completo na memória antes de a
+        // posição do índice indicar que ele existe.
+        __atomic_store_n(&entrada->posicao, posicao, __ATOMIC_RELEASE);
+        cab->usados = necessario;
+        cab->ocupadas++;
+    }
+    flock(cache->arquivo, LOCK_UN);
+    return guardado;
+}
+
+/* Funciona como estimarNavio, mas consulta o cache do ambiente antes
+de estimar e guarda nele a estimativa. */
+bool estimarNavioComCache(const Plataforma *plataforma,
+                          EstimativaDoNavio *estimativa)
+{
+    Cache *cache = cacheDoAmbiente();
+    uint64_t chave = chaveDoCenario("navio", plataforma->bombas,
+                                    plataforma->guindastes,
+                                    plataforma->relogio, NULL, 0);
+    // Um navio que não fica cheio é guardado com segundos negativos.
+    EstimativaDoNavio resultado = {0};
+    if (!consultarCache(cache, chave, &resultado, sizeof(resultado)))
+    {
+        if (!estimarNavio(plataforma, &resultado))
+        {
+            resultado.segundos = -1;
+        }
+        guardarNoCache(cache, chave, &resultado, sizeof(resultado));
+    }
+    if (resultado.segundos < 0)
+    {
+        return false;
+    }
+    *estimativa = resultado;
+    return true;
+}
+
+/* Fecha o cache. Os resultados já guardados ficam no arquivo. */
+void removerCache(Cache *cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+    if (cache->memoria != NULL)
+    {
+        munmap(cache->memoria, cache->capacidade);
+    }
+    if (cache->arquivo >= 0)
+    {
+        close(cache->arquivo);
+    }
+    free(cache);
+}
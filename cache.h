@@ -0,0 +1,88 @@
+#ifndef _CACHE
+#define _CACHE
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bombas.h"
+#include "estimativa.h"
+#include "guindastes.h"
+#include "plataforma.h"
+#include "relogio.h"
+
+/* Variável de ambiente com o caminho do arquivo do cache. Se ela não
+estiver definida, nenhum resultado é guardado. */
+#define VARIAVEL_DO_CACHE "PLATAFORMA_CACHE"
+/* Número inicial de posições do índice do cache. O índice dobra de
+tamanho sempre que três quartos delas estão ocupadas. */
+#define POSICOES_DO_CACHE 4096
+/* Valor inicial do hash FNV-1a de 64 bits. */
+#define FNV_INICIAL 14695981039346656037ULL
+
+/** Cache de resultados de simulações, em um arquivo mapeado na
+memória. Cada resultado é identificado por uma chave, o hash do código
+e das constantes do simulador, do estado inicial da plataforma e do
+comando que o produziu; um resultado guardado é devolvido sem refazer
+a simulação. O arquivo começa por um cabeçalho e um índice com
+endereçamento aberto, que cresce com o cache, seguidos pelos
+resultados. Quando o código ou as constantes mudam, o arquivo é
+substituído por um arquivo vazio ao ser aberto. */
+typedef struct {
+    // Descritor do arquivo do cache.
+    int arquivo;
+    // Início da região mapeada; começa pelo cabeçalho do cache.
+    unsigned char *memoria;
+    // Tamanho da região mapeada, em bytes.
+    size_t capacidade;
+} Cache;
+
+/** Protótipos das funções públicas. */
+
+/* Acrescenta bytes a um hash FNV-1a de 64 bits, começado em
+FNV_INICIAL, e retorna o novo hash. */
+uint64_t hashFNV(uint64_t hash, const void *dados, size_t tamanho);
+
+/* Retorna o hash da versão do simulador: do seu código-fonte (definido
+por HASH_DO_CODIGO na compilação) e das constantes do desafio. */
+uint64_t versaoDoSimulador(void);
+
+/* Retorna a chave do resultado de um comando, com seus argumentos
+numéricos, executado a partir do estado especificado de uma
+plataforma. */
+uint64_t chaveDoCenario(const char *comando, const Bombas *bombas,
+                        const Guindastes *guindastes, Relogio relogio,
+                        const int64_t *argumentos, int n);
+
+/* Abre o cache no arquivo especificado, criando-o se ele não existir,
+e o substitui por um cache vazio se ele for de outra versão do
+simulador. Retorna um apontador nulo se o arquivo não puder ser aberto
+ou mapeado. */
+Cache *AbrirCache(const char *caminho);
+
+/* Retorna o cache do arquivo indicado pela variável de ambiente
+VARIAVEL_DO_CACHE, aberto na primeira chamada e fechado ao fim do
+programa, ou um apontador nulo se ela não estiver definida ou se o
+arquivo não puder ser aberto. */
+Cache *cacheDoAmbiente(void);
+
+/* Copia o resultado guardado com a chave especificada para o endereço
+de memória indicado. Retorna false se o cache for nulo ou se não
+houver um resultado com a chave e o tamanho especificados. */
+bool consultarCache(Cache *cache, uint64_t chave, void *resultado,
+                    size_t tamanho);
+
+/* Guarda um resultado com a chave especificada. Retorna false se o
+cache for nulo ou se o resultado não puder ser gravado. */
+bool guardarNoCache(Cache *cache, uint64_t chave, const void *resultado,
+                    size_t tamanho);
+
+/* Funciona como estimarNavio, mas consulta o cache do ambiente antes
+de estimar e guarda nele a estimativa. */
+bool estimarNavioComCache(const Plataforma *plataforma,
+                          EstimativaDoNavio *estimativa);
+
+/* Fecha o cache. Os resultados já guardados ficam no arquivo. */
+void removerCache(Cache *cache);
+
+#endif // _CACHE
@@ -0,0 +1,53 @@
+/** Controlador embarcado: uma plataforma padrão em memória estática,
+ *  avançada um passo de cada vez. É o ponto de entrada do núcleo do
+ *  controle (energia, bombas, guindastes e corte de carga) quando ele
+ *  é compilado sem o programa principal, para rodar junto aos
+ *  equipamentos.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "controlador.h"
+
+/* O único controlador, e a memória de sua plataforma. */
+static Controlador controlador;
+static unsigned char memoria[MEMORIA_DO_CONTROLADOR]
+    __attribute__((aligned(ALINHAMENTO_DA_ARENA)));
+
+/* Cria o controlador, com o relógio e a capacidade do navio atracado
+(0 para nenhum navio) especificados. Há um único controlador, em
+memória estática: criá-lo de novo o reinicia. Retorna um apontador
+nulo se a plataforma não couber em MEMORIA_DO_CONTROLADOR. */
+Controlador *CriarControlador(Relogio relogio, int capacidadeDoNavio)
+{
+    Arena arena;
+    inicializarArena(&arena, memoria, sizeof(memoria));
+    Plataforma *plataforma = CriarPlataformasNaArena(&arena, 1, NUM_BOMBAS,
+                                                     NUM_GUINDASTES);
+    if (plataforma == NULL)
+    {
+        return NULL;
+    }
+    plataforma->relogio = relogio;
+    atualizarNavio(plataforma->guindastes, capacidadeDoNavio);
+    controlador.plataforma = plataforma;
+    controlador.fracaoDaTermeletrica = 0;
+    controlador.energia = 0;
+    controlador.passos = 0;
+    return &controlador;
+}
+
+/* Dá um passo (um segundo) de controle. Retorna true se há um navio
+na plataforma, false se não. */
+bool passoDoControlador(Controlador *controlador)
+{
+    Plataforma *plataforma = controlador->plataforma;
+    bool navio = passo(plataforma->bombas, plataforma->guindastes,
+                       &plataforma->relogio,
+                       &controlador->fracaoDaTermeletrica, false);
+    controlador->energia += controlador->fracaoDaTermeletrica
+                            * P_TERMELETRICA / 3600;
+    controlador->passos++;
+    return navio;
+}
@@ -0,0 +1,50 @@
+#ifndef _CONTROLADOR
+#define _CONTROLADOR
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "energia.h"
+#include "plataforma.h"
+
+/* Memória estática do controlador, em bytes: uma plataforma padrão,
+com suas bombas e guindastes, como em tamanhoDasPlataformas. */
+#define MEMORIA_DO_CONTROLADOR \
+    (ALINHAR_NA_ARENA(sizeof(Plataforma)) \
+     + ALINHAR_NA_ARENA(sizeof(Bombas)) \
+     + ALINHAR_NA_ARENA(NUM_BOMBAS * sizeof(bool)) \
+     + ALINHAR_NA_ARENA(sizeof(Guindastes)) \
+     + ALINHAR_NA_ARENA(NUM_GUINDASTES * sizeof(int)) \
+     + ALINHAR_NA_ARENA(NUM_GUINDASTES * sizeof(bool)))
+
+/** Controlador de uma plataforma padrão, para uso junto aos
+equipamentos reais. Quando compilado com CONTROLADOR_EMBARCADO (alvo
+'controlador' do makefile), o núcleo do controle usa apenas memória
+estática, sem malloc e sem entrada e saída pelo terminal. Os comandos
+(bombas ativas, guindastes permitidos, navios, emergência) são dados
+diretamente às bombas e aos guindastes da plataforma. */
+typedef struct {
+    // Plataforma controlada, na memória estática do controlador.
+    Plataforma *plataforma;
+    // Fração da capacidade da termelétrica demandada no último passo.
+    double fracaoDaTermeletrica;
+    // Energia fornecida pela termelétrica desde a criação, em kWh.
+    double energia;
+    // Passos dados desde a criação.
+    int64_t passos;
+} Controlador;
+
+/** Protótipos das funções públicas. */
+
+/* Cria o controlador, com o relógio e a capacidade do navio atracado
+(0 para nenhum navio) especificados. Há um único controlador, em
+memória estática: criá-lo de novo o reinicia. Retorna um apontador
+nulo se a plataforma não couber em MEMORIA_DO_CONTROLADOR. */
+Controlador *CriarControlador(Relogio relogio, int capacidadeDoNavio);
+
+/* Dá um passo (um segundo) de controle. Retorna true se há um navio
+na plataforma, false se não. */
+bool passoDoControlador(Controlador *controlador);
+
+#endif // _CONTROLADOR
@@ -0,0 +1,286 @@
+/** Políticas de corte de carga da plataforma. Quando a energia
+ *  disponível não é suficiente para todos os componentes, cada
+ *  política escolhe de um jeito quais guindastes e bombas desligar.
+ *  Os guindastes desligados ficam limitados até o passo seguinte,
+ *  através do limiteDeEnergia; as bombas, exceto na política padrão,
+ *  são desligadas temporariamente e religadas quando a energia volta.
+ *  As políticas só decidem quantos guindastes ficam ativos: a cada
+ *  passo, atualizarGuindastes já reativa os de maior progresso, e os
+ *  guindastes desligados não perdem o progresso, então a escolha de
+ *  quais desligar não muda o resultado da simulação.
+ */
+
+#include <limits.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "arena.h"
+#include "corte.h"
+#include "energia.h"
+#include "plataforma.h"
+
+/* Calcula a potência, em kW, que a plataforma demandaria da
+termelétrica com uma quantidade de bombas e de guindastes ativos e a
+potência especificada das turbinas eólicas. Função local. */
+static double demandaCom(int bombas, int guindastes, double turbinas)
+{
+    double demanda = P_AUXILIAR + bombas * P_BOMBA
+                     + guindastes * P_GUINDASTE - turbinas;
+    // Se a potência das turbinas é suficiente para suprir a demanda.
+    if (demanda < 0)
+    {
+        return 0;
+    }
+    return demanda / E_INVERSORES;
+}
+
+/* Retorna o maior número de guindastes, até o total, que pode ficar
+ativo com uma quantidade de bombas ativas sem que a demanda passe do
+limite. Função local. */
+static int guindastesQueCabem(int bombas, int totais, double turbinas,
+                              double limite)
+{
+    int cabem = totais;
+    while (cabem > 0 && demandaCom(bombas, cabem, turbinas) > limite)
+    {
+        cabem--;
+    }
+    return cabem;
+}
+
+/* Retorna o menor número de bombas, dentre as desejadas, que precisa
+ser desligado para que a demanda caiba no limite com uma quantidade
+de guindastes ativos. Função local. */
+static int bombasParaCortar(int desejadas, int guindastes,
+                            double turbinas, double limite)
+{
+    int cortadas = 0;
+    while (cortadas < desejadas
+           && demandaCom(desejadas - cortadas, guindastes,
+                         turbinas) > limite)
+    {
+        cortadas++;
+    }
+    return cortadas;
+}
+
+/* Retorna o número de guindastes que a plataforma ativaria se houvesse
+energia. Se os guindastes não estão limitados pela energia, é o número
+de ativos; se estão, um a mais, para que a política possa ir
+religando-os aos poucos. Função local. */
+static int guindastesDesejados(Guindastes *guindastes)
+{
+    if (guindastes->ativos < guindastes->limiteDeEnergia
+        || guindastes->ativos >= guindastes->ativosMax)
+    {
+        return guindastes->ativos;
+    }
+    return guindastes->ativos + 1;
+}
+
+/* Desativa os guindastes ativos de maior índice, sem considerar o
+progresso de cada um, até que a quantidade especificada tenha sido
+desativada. Função local. */
+static void desativarUltimosGuindastes(Guindastes *guindastes,
+                                       int quantidade)
+{
+    for (int i = guindastes->totais - 1; i >= 0 && quantidade > 0; i--)
+    {
+        if (guindastes->estados[i])
+        {
+            guindastes->estados[i] = false;
+            guindastes->ativos--;
+            quantidade--;
+        }
+    }
+}
+
+/* Limita a potência demandada ao limite, se ela ainda for maior que
+ele depois do corte. Função local. */
+static double limitar(double demanda, double limite)
+{
+    if (demanda > limite)
+    {
+        return limite;
+    }
+    return demanda;
+}
+
+/* Política padrão: desliga primeiro os guindastes, de maior índice
+para menor, e depois as bombas, permanentemente. Função local. */
+static double cortarPadrao(Bombas *bombas, Guindastes *guindastes,
+                           double turbinas, double limite)
+{
+    // Primeiro, calcula quanta energia deve vir da termelétrica.
+    double subdemanda = demandaCom(bombas->ativas, guindastes->ativos,
+                                   turbinas);
+    // Se não há corte, nem houve no passo anterior, não há o que
+    // ajustar.
+    if (subdemanda <= limite
+        && guindastes->limiteDeEnergia >= guindastes->totais)
+    {
+        return subdemanda;
+    }
+    // Se a demanda da termelétrica é maior que o limite disponível,
+    // desliga primeiro os guindastes e depois as bombas, até que a
+    // energia demandada possa ser fornecida pela usina.
+    int cabem = guindastesQueCabem(bombas->ativas, guindastes->totais,
+                                   turbinas, limite);
+    guindastes->limiteDeEnergia = cabem;
+    desativarUltimosGuindastes(guindastes, guindastes->ativos - cabem);
+    subdemanda = demandaCom(bombas->ativas, guindastes->ativos,
+                            turbinas);
+    while (subdemanda > limite && bombas->ativas > 0)
+    {
+        alterarBombasAtivas(bombas, bombas->ativas - 1);
+        subdemanda -= P_BOMBA / E_INVERSORES;
+    }
+    return limitar(subdemanda, limite);
+}
+
+/* Política que prioriza os guindastes: desliga primeiro bombas,
+temporariamente e em rodízio, trocando as séries desligadas a cada
+PASSOS_DO_RODIZIO passos para que as mesmas não fiquem sempre
+paradas, e só então os guindastes, de maior índice para menor. Função
+local. */
+static double cortarComRotacao(Bombas *bombas, Guindastes *guindastes,
+                               double turbinas, double limite)
+{
+    int desejadas = bombas->ativas + bombas->cortadas;
+    int cortadas = bombasParaCortar(desejadas,
+                                    guindastesDesejados(guindastes),
+                                    turbinas, limite);
+    if (cortadas > 0 || bombas->cortadas > 0)
+    {
+        cortarBombas(bombas, cortadas, true);
+    }
+    int cabem = guindastesQueCabem(bombas->ativas, guindastes->totais,
+                                   turbinas, limite);
+    guindastes->limiteDeEnergia = cabem;
+    if (guindastes->ativos > cabem)
+    {
+        desativarUltimosGuindastes(guindastes, guindastes->ativos - cabem);
+    }
+    return limitar(demandaCom(bombas->ativas, guindastes->ativos,
+                              turbinas), limite);
+}
+
+/* Política proporcional: reduz a potência das bombas e dos
+guindastes na mesma proporção, de acordo com a parcela da demanda de
+cada um. Função local. */
+static double cortarProporcionalmente(Bombas *bombas,
+                                      Guindastes *guindastes,
+                                      double turbinas, double limite)
+{
+    int desejadas = bombas->ativas + bombas->cortadas;
+    int guindastesDesejadosAgora = guindastesDesejados(guindastes);
+    // Potência total que a plataforma pode consumir com o limite,
+    // somando a energia das turbinas.
+    double disponivel = limite * E_INVERSORES + turbinas - P_AUXILIAR;
+    double desejada = desejadas * P_BOMBA
+                      + guindastesDesejadosAgora * P_GUINDASTE;
+    int cortadas = 0;
+    if (desejada > 0 && disponivel < desejada)
+    {
+        double proporcao = disponivel > 0 ? disponivel / desejada : 0;
+        cortadas = desejadas - (int)(desejadas * proporcao);
+    }
+    if (cortadas > 0 || bombas->cortadas > 0)
+    {
+        cortarBombas(bombas, cortadas, true);
+    }
+    // Os guindastes ocupam o que sobrou da energia disponível.
+    int cabem = guindastesQueCabem(bombas->ativas, guindastes->totais,
+                                   turbinas, limite);
+    guindastes->limiteDeEnergia = cabem;
+    if (guindastes->ativos > cabem)
+    {
+        desativarUltimosGuindastes(guindastes, guindastes->ativos - cabem);
+    }
+    return limitar(demandaCom(bombas->ativas, guindastes->ativos,
+                              turbinas), limite);
+}
+
+/* Políticas de corte disponíveis. A primeira é a política padrão. */
+const PoliticaDeCorte politicasDeCorte[NUM_POLITICAS_DE_CORTE] = {
+    {"padrao", "guindastes e depois bombas", cortarPadrao},
+    {"rotacao", "bombas em rodízio primeiro", cortarComRotacao},
+    {"proporcional", "bombas e guindastes na mesma proporção",
+     cortarProporcionalmente}
+};
+
+/* Calcula a potência, em kW, que os componentes da plataforma
+consumiriam no horário especificado, em horas, se não houvesse corte
+de carga: com as bombas desligadas temporariamente religadas e, se os
+guindastes estiverem limitados pela energia e puderem funcionar nesse
+horário, com o número máximo de guindastes ativos. A energia das
+turbinas eólicas não é descontada. */
+double cargaSemCorte(Bombas *bombas, Guindastes *guindastes, int horario)
+{
+    // Os guindastes só funcionam no horário deles e com um navio
+    // atracado, ou preparando barris; fora disso, ficam parados mesmo
+    // sem corte.
+    bool podemFuncionar = horarioDosGuindastes(horario)
+                          && (guindastes->estadoDoNavio != 0
+                              || guindastes->preparacao);
+    int guindastesAtivos = guindastes->ativos;
+    if (podemFuncionar
+        && guindastes->ativos >= guindastes->limiteDeEnergia)
+    {
+        guindastesAtivos = guindastes->ativosMax;
+    }
+    return P_AUXILIAR + (bombas->ativas + bombas->cortadas) * P_BOMBA
+           + guindastesAtivos * P_GUINDASTE;
+}
+
+/* Procura uma política de corte pelo nome. Retorna um apontador nulo
+se não houver política com esse nome. */
+const PoliticaDeCorte *acharPoliticaDeCorte(const char *nome)
+{
+    for (int i = 0; i < NUM_POLITICAS_DE_CORTE; i++)
+    {
+        if (!strcmp(politicasDeCorte[i].nome, nome))
+        {
+            return &politicasDeCorte[i];
+        }
+    }
+    return NULL;
+}
+
+#ifndef CONTROLADOR_EMBARCADO
+/* Simula uma plataforma padrão, com um navio de capacidade extrema,
+por uma quantidade de passos, com a energia da termelétrica limitada
+a limite kW e a política de corte especificada. O desempenho é
+colocado no endereço de memória especificado. Retorna false se não
+houver memória suficiente. */
+bool avaliarPoliticaDeCorte(const PoliticaDeCorte *politica,
+                            double limite, int64_t passos,
+                            Desempenho *desempenho)
+{
+    Arena *arena = CriarArena(tamanhoDasPlataformas(1, NUM_BOMBAS,
+                                                    NUM_GUINDASTES));
+    if (arena == NULL)
+    {
+        return false;
+    }
+    Plataforma *plataforma = CriarPlataformasNaArena(arena, 1, NUM_BOMBAS,
+                                                     NUM_GUINDASTES);
+    Guindastes *guindastes = plataforma->guindastes;
+    atualizarNavio(guindastes, INT_MAX);
+    desempenho->energia = 0;
+    for (int64_t i = 0; i < passos; i++)
+    {
+        plataforma->relogio++;
+        int hora = horaDoRelogio(plataforma->relogio);
+        atualizarGuindastes(guindastes, hora);
+        double potencia = ajustarDemandaComLimite(plataforma->bombas,
+                                                  guindastes, hora, limite,
+                                                  politica);
+        desempenho->energia += potencia / 3600;
+    }
+    desempenho->barris = INT_MAX - guindastes->estadoDoNavio;
+    desempenho->custo = desempenho->energia * C_TERMELETRICA;
+    removerArena(arena);
+    return true;
+}
+#endif
@@ -0,0 +1,71 @@
+#ifndef _CORTE
+#define _CORTE
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bombas.h"
+#include "guindastes.h"
+
+/* Função que desliga guindastes e bombas até que a potência demandada
+da termelétrica caiba no limite, em kW, com a potência das turbinas
+eólicas disponível para a plataforma, em kW. Retorna a potência, em kW,
+que deve ser fornecida pela termelétrica à plataforma. */
+typedef double (*FuncaoDeCorte)(Bombas *bombas, Guindastes *guindastes,
+                                double turbinas, double limite);
+
+/** Política de corte de carga: a maneira de escolher quais guindastes
+e bombas são desligados quando a energia disponível para a plataforma
+não é suficiente para todos eles. */
+typedef struct {
+    // Nome da política, usado na linha de comando.
+    const char *nome;
+    // Descrição curta da política, usada nos relatórios.
+    const char *descricao;
+    // Função que aplica a política.
+    FuncaoDeCorte cortar;
+} PoliticaDeCorte;
+
+/** Desempenho de uma plataforma padrão durante uma simulação com a
+energia limitada. */
+typedef struct {
+    // Barris carregados nos navios.
+    long barris;
+    // Energia fornecida pela termelétrica, em kWh.
+    double energia;
+    // Custo da energia fornecida pela termelétrica, em reais.
+    double custo;
+} Desempenho;
+
+/* Número de políticas de corte disponíveis. */
+#define NUM_POLITICAS_DE_CORTE 3
+
+/* Políticas de corte disponíveis. A primeira é a política padrão. */
+extern const PoliticaDeCorte politicasDeCorte[NUM_POLITICAS_DE_CORTE];
+
+/** Protótipos das funções públicas. */
+
+/* Calcula a potência, em kW, que os componentes da plataforma
+consumiriam no horário especificado, em horas, se não houvesse corte
+de carga: com as bombas desligadas temporariamente religadas e, se os
+guindastes estiverem limitados pela energia e puderem funcionar nesse
+horário, com o número máximo de guindastes ativos. A energia das
+turbinas eólicas não é descontada. */
+double cargaSemCorte(Bombas *bombas, Guindastes *guindastes, int horario);
+
+/* Procura uma política de corte pelo nome. Retorna um apontador nulo
+se não houver política com esse nome. */
+const PoliticaDeCorte *acharPoliticaDeCorte(const char *nome);
+
+#ifndef CONTROLADOR_EMBARCADO
+/* Simula uma plataforma padrão, com um navio de capacidade extrema,
+por uma quantidade de passos, com a energia da termelétrica limitada
+a limite kW e a política de corte especificada. O desempenho é
+colocado no endereço de memória especificado. Retorna false se não
+houver memória suficiente. */
+bool avaliarPoliticaDeCorte(const PoliticaDeCorte *politica,
+                            double limite, int64_t passos,
+                            Desempenho *desempenho);
+#endif
+
+#endif // _CORTE
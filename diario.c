@@ -0,0 +1,414 @@
+/** Diário das sessões do modo interativo, em um arquivo mapeado na
+ *  memória. O arquivo começa por um cabeçalho, seguido pelos registros,
+ *  cada um com um tipo e um tamanho. Um registro só passa a fazer parte
+ *  do diário quando o número de bytes usados no cabeçalho é atualizado,
+ *  depois de o registro ter sido escrito; assim, um registro
+ *  interrompido no meio é simplesmente ignorado na recuperação.
+ *  Os registros sobrevivem à interrupção do programa, já que ficam na
+ *  memória do sistema; os pontos de recuperação também são gravados no
+ *  disco, com msync, para sobreviver à falta de energia.
+ */
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "diario.h"
+
+/* Identificação dos arquivos de diário, e de sua versão. */
+#define ASSINATURA_DO_DIARIO "PLTDIAR3"
+/* Tamanho inicial do arquivo do diário, em bytes. Dobra sempre que
+não houver espaço para um novo registro. */
+#define CAPACIDADE_INICIAL_DO_DIARIO (64 * 1024)
+/* Alinhamento dos registros no arquivo, em bytes. */
+#define ALINHAMENTO_DO_DIARIO 8
+
+/* Tipos de registros do diário. */
+enum {
+    REGISTRO_COMANDO = 1,
+    REGISTRO_PONTO = 2
+};
+
+/** Cabeçalho do arquivo do diário. */
+typedef struct {
+    char assinatura[8];
+    int32_t totaisBombas;
+    int32_t totaisGuindastes;
+    // Bytes usados no arquivo, incluindo o cabeçalho. Tudo o que vem
+    // depois é ignorado.
+    uint64_t usados;
+    // Posição do último ponto de recuperação, ou 0 se não houver.
+    uint64_t ultimoPonto;
+} CabecalhoDoDiario;
+
+/** Início de cada registro. O conteúdo vem logo em seguida. */
+typedef struct {
+    uint32_t tipo;
+    // Tamanho do conteúdo, em bytes, sem o alinhamento.
+    uint32_t tamanho;
+} Registro;
+
+/** Conteúdo de um registro de comando. */
+typedef struct {
+    int32_t comando;
+    int32_t argumento;
+} RegistroDeComando;
+
+/** Parte fixa de um ponto de recuperação. Em seguida vêm os
+progressos e os estados dos guindastes e os estados das bombas. */
+typedef struct {
+    double custoTotal;
+    int64_t relogio;
+    int32_t mostrarFracao;
+    int32_t bombasAtivas, luzAmarela, luzVermelha, cortadas, rotacao;
+    int32_t passosNoRodizio;
+    int32_t guindastesAtivos, ativosMax, limiteDeEnergia, carregando;
+    int32_t estadoDoNavio, preparacao, barrisPreparados;
+} PontoDeRecuperacao;
+
+/* Arredonda um tamanho para o alinhamento dos registros. Função
+local. */
+static size_t alinhar(size_t bytes)
+{
+    return (bytes + ALINHAMENTO_DO_DIARIO - 1)
+           & ~(size_t)(ALINHAMENTO_DO_DIARIO - 1);
+}
+
+/* Retorna o cabeçalho do diário. Função local. */
+static CabecalhoDoDiario *cabecalho(Diario *diario)
+{
+    return (CabecalhoDoDiario *)diario->memoria;
+}
+
+/* Tamanho do conteúdo de um ponto de recuperação. Função local. */
+static size_t tamanhoDoPonto(Diario *diario)
+{
+    return sizeof(PontoDeRecuperacao)
+           + diario->totaisGuindastes * sizeof(int32_t)
+           + diario->totaisGuindastes + diario->totaisBombas;
+}
+
+/* Mapeia o arquivo do diário com a capacidade especificada, aumentando
+o arquivo se necessário. Retorna false se não for possível; nesse caso,
+o mapeamento anterior continua válido. Função local. */
+static bool mapearDiario(Diario *diario, size_t capacidade)
+{
+    // Aumentar o arquivo não invalida o mapeamento anterior, que só é
+    // desfeito depois de o novo ter sido criado.
+    if (capacidade > diario->capacidade
+        && ftruncate(diario->arquivo, capacidade) != 0)
+    {
+        return false;
+    }
+    void *memoria = mmap(NULL, capacidade, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, diario->arquivo, 0);
+    if (memoria == MAP_FAILED)
+    {
+        return false;
+    }
+    if (diario->memoria != NULL)
+    {
+        munmap(diario->memoria, diario->capacidade);
+    }
+    diario->memoria = memoria;
+    diario->capacidade = capacidade;
+    return true;
+}
+
+/* Reserva espaço para um registro no fim do diário, aumentando o
+arquivo se necessário, e escreve seu início. Retorna o endereço do
+conteúdo do registro, ou um apontador nulo se não houver espaço. O
+registro só passa a fazer parte do diário em publicarRegistro. Função
+local. */
+static void *novoRegistro(Diario *diario, uint32_t tipo, size_t tamanho)
+{
+    size_t usados = cabecalho(diario)->usados;
+    size_t necessario = usados + sizeof(Registro) + alinhar(tamanho);
+    if (necessario > diario->capacidade)
+    {
+        size_t capacidade = diario->capacidade;
+        while (capacidade < necessario)
+        {
+            capacidade *= 2;
+        }
+        if (!mapearDiario(diario, capacidade))
+        {
+            return NULL;
+        }
+    }
+    Registro *registro = (Registro *)(diario->memoria + usados);
+    registro->tipo = tipo;
+    registro->tamanho = tamanho;
+    return registro + 1;
+}
+
+/* Publica o último registro reservado por novoRegistro, que passa a
+fazer parte do diário. Função local. */
+static void publicarRegistro(Diario *diario)
+{
+    CabecalhoDoDiario *cab = cabecalho(diario);
+    Registro *registro = (Registro *)(diario->memoria + cab->usados);
+    uint64_t usados = cab->usados + sizeof(Registro)
+                      + alinhar(registro->tamanho);
+    // O registro deve estar completo na memória antes de o cabeçalho
+    // indicar que ele existe.
+    __atomic_store_n(&cab->usados, usados, __ATOMIC_RELEASE);
+}
+
+/* Abre o diário no arquivo especificado, criando-o se ele não existir,
+para uma plataforma com o número de séries de bombas e de guindastes
+especificado. Retorna um apontador nulo se o arquivo não puder ser
+aberto ou mapeado, ou se for de uma plataforma diferente. */
+Diario *AbrirDiario(const char *caminho, int num_bombas,
+                    int num_guindastes)
+{
+    Diario *diario = malloc(sizeof(Diario));
+    if (diario == NULL)
+    {
+        return NULL;
+    }
+    diario->arquivo = open(caminho, O_RDWR | O_CREAT, 0644);
+    diario->memoria = NULL;
+    diario->capacidade = 0;
+    diario->leitura = 0;
+    diario->totaisBombas = num_bombas;
+    diario->totaisGuindastes = num_guindastes;
+    diario->comandosDesdeOPonto = 0;
+    struct stat informacoes;
+    if (diario->arquivo < 0 || fstat(diario->arquivo, &informacoes) != 0)
+    {
+        removerDiario(diario);
+        return NULL;
+    }
+    bool novo = informacoes.st_size < (off_t)sizeof(CabecalhoDoDiario);
+    size_t capacidade = novo ? CAPACIDADE_INICIAL_DO_DIARIO
+                             : (size_t)informacoes.st_size;
+    if (!mapearDiario(diario, capacidade))
+    {
+        removerDiario(diario);
+        return NULL;
+    }
+    CabecalhoDoDiario *cab = cabecalho(diario);
+    if (novo)
+    {
+        memcpy(cab->assinatura, ASSINATURA_DO_DIARIO, 8);
+        cab->totaisBombas = num_bombas;
+        cab->totaisGuindastes = num_guindastes;
+        cab->usados = sizeof(CabecalhoDoDiario);
+        cab->ultimoPonto = 0;
+    }
+    // Um diário de outra versão, de outra plataforma ou corrompido
+    // não é usado.
+    else if (memcmp(cab->assinatura, ASSINATURA_DO_DIARIO, 8)
+             || cab->totaisBombas != num_bombas
+             || cab->totaisGuindastes != num_guindastes
+             || cab->usados < sizeof(CabecalhoDoDiario)
+             || cab->usados > diario->capacidade
+             || cab->ultimoPonto >= cab->usados)
+    {
+        removerDiario(diario);
+        return NULL;
+    }
+    return diario;
+}
+
+/* Acrescenta um comando, e seu argumento numérico, ao diário. Não faz
+nada se o diário for nulo. Retorna false se não houver espaço. */
+bool registrarComando(Diario *diario, char comando, int argumento)
+{
+    if (diario == NULL)
+    {
+        return true;
+    }
+    RegistroDeComando *registro = novoRegistro(diario, REGISTRO_COMANDO,
+                                               sizeof(RegistroDeComando));
+    if (registro == NULL)
+    {
+        return false;
+    }
+    registro->comando = comando;
+    registro->argumento = argumento;
+    publicarRegistro(diario);
+    diario->comandosDesdeOPonto++;
+    return true;
+}
+
+/* Acrescenta um ponto de recuperação, com todo o estado da sessão, ao
+diário, e grava o diário no disco. Não faz nada se o diário for nulo.
+Retorna false se não houver espaço. */
+bool registrarPonto(Diario *diario, const Sessao *sessao)
+{
+    if (diario == NULL)
+    {
+        return true;
+    }
+    PontoDeRecuperacao *ponto = novoRegistro(diario, REGISTRO_PONTO,
+                                             tamanhoDoPonto(diario));
+    if (ponto == NULL)
+    {
+        return false;
+    }
+    Bombas *bombas = sessao->bombas;
+    Guindastes *guindastes = sessao->guindastes;
+    ponto->custoTotal = *sessao->custoTotal;
+    ponto->relogio = *sessao->relogio;
+    ponto->mostrarFracao = *sessao->mostrarFracao;
+    ponto->bombasAtivas = bombas->ativas;
+    ponto->luzAmarela = bombas->luzAmarela;
+    ponto->luzVermelha = bombas->luzVermelha;
+    ponto->cortadas = bombas->cortadas;
+    ponto->rotacao = bombas->rotacao;
+    ponto->passosNoRodizio = bombas->passosNoRodizio;
+    ponto->guindastesAtivos = guindastes->ativos;
+    ponto->ativosMax = guindastes->ativosMax;
+    ponto->limiteDeEnergia = guindastes->limiteDeEnergia;
+    ponto->carregando = guindastes->carregando;
+    ponto->estadoDoNavio = guindastes->estadoDoNavio;
+    ponto->preparacao = guindastes->preparacao;
+    ponto->barrisPreparados = guindastes->barrisPreparados;
+    // Listas, logo depois da parte fixa.
+    unsigned char *listas = (unsigned char *)(ponto + 1);
+    int32_t *progressos = (int32_t *)listas;
+    for (int i = 0; i < guindastes->totais; i++)
+    {
+        progressos[i] = guindastes->progressos[i];
+    }
+    listas += guindastes->totais * sizeof(int32_t);
+    for (int i = 0; i < guindastes->totais; i++)
+    {
+        listas[i] = guindastes->estados[i];
+    }
+    listas += guindastes->totais;
+    for (int i = 0; i < bombas->totais; i++)
+    {
+        listas[i] = bombas->estados[i];
+    }
+    uint64_t posicao = cabecalho(diario)->usados;
+    publicarRegistro(diario);
+    cabecalho(diario)->ultimoPonto = posicao;
+    diario->comandosDesdeOPonto = 0;
+    // Só os pontos de recuperação são gravados no disco imediatamente.
+    msync(diario->memoria, cabecalho(diario)->usados, MS_SYNC);
+    return true;
+}
+
+/* Restaura o estado da sessão a partir do ponto de recuperação na
+posição especificada. Função local. */
+static void restaurarPonto(Diario *diario, size_t posicao, Sessao *sessao)
+{
+    const PontoDeRecuperacao *ponto =
+        (const PontoDeRecuperacao *)(diario->memoria + posicao
+                                     + sizeof(Registro));
+    Bombas *bombas = sessao->bombas;
+    Guindastes *guindastes = sessao->guindastes;
+    *sessao->custoTotal = ponto->custoTotal;
+    *sessao->relogio = ponto->relogio;
+    *sessao->mostrarFracao = ponto->mostrarFracao;
+    bombas->ativas = ponto->bombasAtivas;
+    bombas->luzAmarela = ponto->luzAmarela;
+    bombas->luzVermelha = ponto->luzVermelha;
+    bombas->cortadas = ponto->cortadas;
+    bombas->rotacao = ponto->rotacao;
+    bombas->passosNoRodizio = ponto->passosNoRodizio;
+    guindastes->ativos = ponto->guindastesAtivos;
+    guindastes->ativosMax = ponto->ativosMax;
+    guindastes->limiteDeEnergia = ponto->limiteDeEnergia;
+    guindastes->carregando = ponto->carregando;
+    guindastes->estadoDoNavio = ponto->estadoDoNavio;
+    guindastes->preparacao = ponto->preparacao;
+    guindastes->barrisPreparados = ponto->barrisPreparados;
+    const unsigned char *listas = (const unsigned char *)(ponto + 1);
+    const int32_t *progressos = (const int32_t *)listas;
+    for (int i = 0; i < guindastes->totais; i++)
+    {
+        guindastes->progressos[i] = progressos[i];
+    }
+    listas += guindastes->totais * sizeof(int32_t);
+    for (int i = 0; i < guindastes->totais; i++)
+    {
+        guindastes->estados[i] = listas[i];
+    }
+    listas += guindastes->totais;
+    for (int i = 0; i < bombas->totais; i++)
+    {
+        bombas->estados[i] = listas[i];
+    }
+}
+
+/* Restaura o estado da sessão a partir do último ponto de recuperação
+do diário, e prepara a leitura dos comandos registrados depois dele.
+Retorna false se o diário não tiver nenhum ponto de recuperação. */
+bool recuperarPonto(Diario *diario, Sessao *sessao)
+{
+    CabecalhoDoDiario *cab = cabecalho(diario);
+    if (cab->ultimoPonto == 0)
+    {
+        return false;
+    }
+    restaurarPonto(diario, cab->ultimoPonto, sessao);
+    Registro *registro = (Registro *)(diario->memoria + cab->ultimoPonto);
+    diario->leitura = cab->ultimoPonto + sizeof(Registro)
+                      + alinhar(registro->tamanho);
+    diario->comandosDesdeOPonto = 0;
+    return true;
+}
+
+/* Lê o próximo comando registrado depois do ponto de recuperação.
+Pontos de recuperação encontrados no caminho também são restaurados.
+Retorna false quando não houver mais comandos. */
+bool proximoComando(Diario *diario, Sessao *sessao, char *comando,
+                    int *argumento)
+{
+    CabecalhoDoDiario *cab = cabecalho(diario);
+    while (diario->leitura + sizeof(Registro) <= cab->usados)
+    {
+        size_t posicao = diario->leitura;
+        Registro *registro = (Registro *)(diario->memoria + posicao);
+        diario->leitura += sizeof(Registro) + alinhar(registro->tamanho);
+        if (diario->leitura > cab->usados)
+        {
+            return false;
+        }
+        // Um ponto gravado sem que o cabeçalho tenha sido atualizado
+        // (o programa foi interrompido entre as duas escritas) também
+        // é usado.
+        if (registro->tipo == REGISTRO_PONTO)
+        {
+            restaurarPonto(diario, posicao, sessao);
+            cab->ultimoPonto = posicao;
+            diario->comandosDesdeOPonto = 0;
+            continue;
+        }
+        const RegistroDeComando *conteudo =
+            (const RegistroDeComando *)(registro + 1);
+        *comando = conteudo->comando;
+        *argumento = conteudo->argumento;
+        diario->comandosDesdeOPonto++;
+        return true;
+    }
+    return false;
+}
+
+/* Grava o diário no disco e o fecha. */
+void removerDiario(Diario *diario)
+{
+    if (diario == NULL)
+    {
+        return;
+    }
+    if (diario->memoria != NULL)
+    {
+        msync(diario->memoria, diario->capacidade, MS_SYNC);
+        munmap(diario->memoria, diario->capacidade);
+    }
+    if (diario->arquivo >= 0)
+    {
+        close(diario->arquivo);
+    }
+    free(diario);
+}
@@ -0,0 +1,89 @@
+#ifndef _DIARIO
+#define _DIARIO
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bombas.h"
+#include "guindastes.h"
+#include "relogio.h"
+
+/* Número máximo de comandos registrados entre dois pontos de
+recuperação. */
+#define COMANDOS_ENTRE_PONTOS 64
+/* Número máximo de passos simulados entre dois pontos de recuperação
+(um dia). Limita o tempo de recuperação, que nunca precisa refazer mais
+que esses passos e o último comando. */
+#define PASSOS_ENTRE_PONTOS (60 * 60 * 24)
+
+/** Estado de uma sessão do modo interativo, salvo nos pontos de
+recuperação. Aponta para as variáveis do próprio modo interativo, que
+são alteradas diretamente ao recuperar a sessão. */
+typedef struct {
+    Bombas *bombas;
+    Guindastes *guindastes;
+    Relogio *relogio;
+    // Custo acumulado desde o início da sessão.
+    double *custoTotal;
+    // true se a demanda da termelétrica é mostrada a cada passo.
+    bool *mostrarFracao;
+} Sessao;
+
+/** Diário de uma sessão do modo interativo, guardado em um arquivo
+mapeado na memória. Cada comando que altera o estado da simulação é
+acrescentado ao fim do diário, e de tempos em tempos um ponto de
+recuperação, com todo o estado, também. Os registros são escritos
+diretamente na memória mapeada, sem chamadas ao sistema; só os pontos
+de recuperação forçam a gravação no disco. Se o programa for
+interrompido, a sessão é recuperada a partir do último ponto,
+refazendo apenas os comandos registrados depois dele. */
+typedef struct {
+    // Descritor do arquivo do diário.
+    int arquivo;
+    // Início da região mapeada; começa pelo cabeçalho do diário.
+    unsigned char *memoria;
+    // Tamanho da região mapeada (e do arquivo), em bytes.
+    size_t capacidade;
+    // Posição do próximo registro lido por proximoComando.
+    size_t leitura;
+    // Números de bombas e de guindastes da plataforma registrada.
+    int totaisBombas;
+    int totaisGuindastes;
+    // Comandos registrados desde o último ponto de recuperação.
+    int comandosDesdeOPonto;
+} Diario;
+
+/** Protótipos das funções públicas. */
+
+/* Abre o diário no arquivo especificado, criando-o se ele não existir,
+para uma plataforma com o número de séries de bombas e de guindastes
+especificado. Retorna um apontador nulo se o arquivo não puder ser
+aberto ou mapeado, ou se for de uma plataforma diferente. */
+Diario *AbrirDiario(const char *caminho, int num_bombas,
+                    int num_guindastes);
+
+/* Acrescenta um comando, e seu argumento numérico, ao diário. Não faz
+nada se o diário for nulo. Retorna false se não houver espaço. */
+bool registrarComando(Diario *diario, char comando, int argumento);
+
+/* Acrescenta um ponto de recuperação, com todo o estado da sessão, ao
+diário, e grava o diário no disco. Não faz nada se o diário for nulo.
+Retorna false se não houver espaço. */
+bool registrarPonto(Diario *diario, const Sessao *sessao);
+
+/* Restaura o estado da sessão a partir do último ponto de recuperação
+do diário, e prepara a leitura dos comandos registrados depois dele.
+Retorna false se o diário não tiver nenhum ponto de recuperação. */
+bool recuperarPonto(Diario *diario, Sessao *sessao);
+
+/* Lê o próximo comando registrado depois do ponto de recuperação.
+Pontos de recuperação encontrados no caminho também são restaurados.
+Retorna false quando não houver mais comandos. */
+bool proximoComando(Diario *diario, Sessao *sessao, char *comando,
+                    int *argumento);
+
+/* Grava o diário no disco e o fecha. */
+void removerDiario(Diario *diario);
+
+#endif // _DIARIO
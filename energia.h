@@ -2,9 +2,13 @@
 #define _ENERGIA
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "bombas.h"
 #include "guindastes.h"
+#include "atribuicao.h"
+#include "corte.h"
+#include "relogio.h"
 
 /* Número de turbinas eólicas, definido pelo desafio. */
 #define NUM_TURBINAS 50
@@ -21,23 +25,44 @@ calculado pela equipe baseado nos dados fornecidos pelo desafio. */
 #define E_INVERSORES 0.95
 
 /* Dá uma quantidade pré-determinada de passos, e retorna o custo
-total dessas etapas. */
-double passosN(int passos, Bombas *bombas, Guindastes *guindastes,
-               int *hora, int *minuto, int *segundo, bool mostraFracao);
+total dessas etapas. Se atribuicao não for nulo, a energia de cada
+passo também é atribuída aos consumidores da plataforma. */
+double passosN(int64_t passos, Bombas *bombas, Guindastes *guindastes,
+               Relogio *relogio, bool mostraFracao,
+               Atribuicao *atribuicao);
+
+/* Funciona como passosN, mas também acumula, em uma única passagem, o
+custo de cada dia e de cada mês do calendário. O custo de cada passo é
+acumulado no dia e no mês em que ele começa; o índice 0 de cada vetor
+é o dia e o mês do horário inicial. Os vetores, se não forem nulos,
+devem ter espaço para todos os dias e meses que os passos alcançam, e
+não são zerados antes. */
+double passosComResumo(int64_t passos, Bombas *bombas,
+                       Guindastes *guindastes, Relogio *relogio,
+                       double *custosDiarios, double *custosMensais,
+                       Atribuicao *atribuicao);
 
 /* Funciona como passosN, mas em vez de dar uma quantidade pré-
 -determinada de passos, avança a simulação até o navio atracado
 na plataforma atingir sua capacidade. */
-double passosNavio(Bombas *bombas, Guindastes *guindastes, int *hora,
-                   int *minuto, int *segundo, bool mostrarFracao);
+double passosNavio(Bombas *bombas, Guindastes *guindastes,
+                   Relogio *relogio, bool mostrarFracao,
+                   Atribuicao *atribuicao);
+
+/* Funciona como passosN, mas simula uma sequência de navios com a
+capacidade especificada: quando um navio fica cheio, o próximo atraca
+TEMPO_DE_TROCA segundos depois. O número de navios que ficaram cheios
+é colocado no endereço de memória especificado. */
+double passosComTrocas(int64_t passos, Bombas *bombas,
+                       Guindastes *guindastes, Relogio *relogio,
+                       int capacidade, int *navios);
 
 /* Simula um passo (um minuto) de operação da plataforma. Retorna
 true se há um navio na plataforma, false se não. A fração da
 capacidade da termelétrica que é demandada pela plataforma é
 colocada no endereço de memória especificado. */
-bool passo(Bombas *bombas, Guindastes *guindastes, int *hora,
-           int *minuto, int *segundo, double *fracaoDaTermeletrica,
-           bool mostrarFracao);
+bool passo(Bombas *bombas, Guindastes *guindastes, Relogio *relogio,
+           double *fracaoDaTermeletrica, bool mostrarFracao);
 
 /* Calcula a porcentagem da demanda da termelétrica que deve ser
 direcionada para a plataforma de petróleo para a sua operação e, se
@@ -47,23 +72,42 @@ que deve ser direcionada à plataforma. */
 double ajustarDemanda(Bombas *bombas, Guindastes *guindastes,
                       int horario);
 
+/* Funciona como ajustarDemanda, mas a plataforma dispõe de apenas
+parte da capacidade da termelétrica, dada em kW pelo limite, e os
+componentes são desligados de acordo com a política de corte
+especificada (a padrão, se for nula). Retorna a potência, em kW, que
+deve ser fornecida pela termelétrica à plataforma. */
+double ajustarDemandaComLimite(Bombas *bombas, Guindastes *guindastes,
+                               int horario, double limite,
+                               const PoliticaDeCorte *politica);
+
+/* Funciona como ajustarDemandaComLimite, mas a plataforma dispõe
+apenas da potência especificada das turbinas eólicas, em kW, em vez de
+todo o parque eólico. Usado quando o parque é dividido entre várias
+plataformas. */
+double ajustarDemandaComTurbinas(Bombas *bombas, Guindastes *guindastes,
+                                 double turbinas, double limite,
+                                 const PoliticaDeCorte *politica);
+
+/* Calcula a potência, em kW, consumida pelos componentes ativos da
+plataforma, antes de descontar a energia das turbinas eólicas. */
+double cargaDaPlataforma(Bombas *bombas, Guindastes *guindastes);
+
+/* Calcula a potência, em kW, que a plataforma demandaria da
+termelétrica em um horário do dia, sem desligar nenhum componente. */
+double demandaDaPlataforma(Bombas *bombas, Guindastes *guindastes,
+                           int horario);
+
 /* Calcula a potência que deve ser fornecida pela termelétrica, dado
 um horário do dia e uma demanda total, em kW. */
 double demandaDaTermeletrica(double demandaTotal, int horario);
 
+/* Calcula a potência gerada por uma turbina eólica, em kW, em um
+certo horário do dia, antes dos inversores. */
+double potenciaPorTurbina(int horario);
+
 /* Calcula a potência gerada pelas turbinas eólicas, em kW, em um
 certo horário do dia. */
 double potenciaDasTurbinas(int horario);
 
-/* Solicita um número do usuário dentro de um limite. */
-int getNum(int minimo, int maximo);
-
-/* Retorna true se str for uma string numérica, false se não. */
-bool strNumerica(char *str);
-
-/* Mostra as instruções de uso do programa e do modo interativo,
-respectivamente. */
-void ajudaDoPrograma(void);
-void ajudoDoModoInterativo(void);
-
 #endif // _ENERGIA
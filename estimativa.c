@@ -0,0 +1,377 @@
+/** Estima quando o navio atracado ficará cheio sem simular cada
+ *  segundo. Enquanto todos os guindastes estão ativos, sem corte de
+ *  carga e com espaço de sobra no navio, cada guindaste carrega
+ *  exatamente um barril a cada TEMPO_DE_COLETA + TEMPO_DE_CARREGAMENTO
+ *  segundos, e volta à mesma posição; esses ciclos são saltados de uma
+ *  vez. Com parte dos guindastes ativos, o movimento também se repete,
+ *  mas o período é descoberto simulando até os guindastes voltarem ao
+ *  mesmo estado; os períodos seguintes são saltados do mesmo jeito.
+ *  Fora do horário dos guindastes, nada muda além do relógio, e o
+ *  período inteiro também é saltado. Só o resto (o início e o fim de
+ *  cada turno e o fim do navio) é simulado passo a passo.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "energia.h"
+#include "estimativa.h"
+
+/* Duração de um ciclo de um guindaste, em passos. */
+#define CICLO_DO_GUINDASTE (TEMPO_DE_COLETA + TEMPO_DE_CARREGAMENTO)
+/* Maior período, em passos, procurado no movimento de uma frota com
+parte dos guindastes ativos. */
+#define PERIODO_MAXIMO (8 * CICLO_DO_GUINDASTE)
+/* Maior número de guindastes para o qual o período é procurado. */
+#define GUINDASTES_NO_PERIODO 64
+
+/* Calcula a potência, em kW, que a plataforma demanda da termelétrica
+com as bombas atuais e uma quantidade de guindastes ativos. Função
+local. */
+static double demandaCom(const Plataforma *plataforma, int guindastes,
+                         int horario)
+{
+    return demandaDaTermeletrica(P_AUXILIAR
+                                 + plataforma->bombas->ativas * P_BOMBA
+                                 + guindastes * P_GUINDASTE, horario);
+}
+
+/* Retorna o número de passos, a partir do horário agora (em segundos
+do dia), cujo horário tem a mesma hora que o do próximo passo. Função
+local. */
+static long passosNaHora(long agora)
+{
+    long proximo = (agora + 1) % SEGUNDOS_NO_DIA;
+    return (proximo / 3600 + 1) * 3600 - proximo;
+}
+
+/* Calcula o custo de uma quantidade de passos com um número constante
+de guindastes ativos, a partir do horário agora (em segundos do dia),
+somando hora a hora. Retorna um valor negativo se, em alguma das horas,
+a demanda passar da capacidade da termelétrica (e houver corte de
+carga). Função local. */
+static double custoConstante(const Plataforma *plataforma, long agora,
+                             long passos, int guindastes)
+{
+    double custo = 0;
+    while (passos > 0)
+    {
+        long naHora = passosNaHora(agora);
+        if (naHora > passos)
+        {
+            naHora = passos;
+        }
+        int horario = (agora + 1) % SEGUNDOS_NO_DIA / 3600;
+        double demanda = demandaCom(plataforma, guindastes, horario);
+        if (demanda > P_TERMELETRICA)
+        {
+            return -1;
+        }
+        custo += naHora * (demanda * C_TERMELETRICA / 3600);
+        agora = (agora + naHora) % SEGUNDOS_NO_DIA;
+        passos -= naHora;
+    }
+    return custo;
+}
+
+/* Funciona como custoConstante, mas o número de guindastes ativos
+em cada passo se repete com o período especificado, na ordem da lista
+ativosNoPasso. Função local. */
+static double custoPeriodico(const Plataforma *plataforma, long agora,
+                             long passos, const int *ativosNoPasso,
+                             int periodo)
+{
+    int totais = plataforma->guindastes->totais;
+    long contagens[GUINDASTES_NO_PERIODO + 1];
+    double custo = 0;
+    int fase = 0;
+    while (passos > 0)
+    {
+        long naHora = passosNaHora(agora);
+        if (naHora > passos)
+        {
+            naHora = passos;
+        }
+        // Conta quantos passos da hora têm cada número de guindastes
+        // ativos: os períodos inteiros e o começo do seguinte.
+        memset(contagens, 0, (totais + 1) * sizeof(long));
+        long voltas = naHora / periodo;
+        int resto = naHora % periodo;
+        for (int j = 0; j < periodo; j++)
+        {
+            contagens[ativosNoPasso[j]] += voltas;
+        }
+        for (int j = 0; j < resto; j++)
+        {
+            contagens[ativosNoPasso[(fase + j) % periodo]]++;
+        }
+        fase = (fase + resto) % periodo;
+        int horario = (agora + 1) % SEGUNDOS_NO_DIA / 3600;
+        for (int g = 0; g <= totais; g++)
+        {
+            if (contagens[g] == 0)
+            {
+                continue;
+            }
+            double demanda = demandaCom(plataforma, g, horario);
+            if (demanda > P_TERMELETRICA)
+            {
+                return -1;
+            }
+            custo += contagens[g] * (demanda * C_TERMELETRICA / 3600);
+        }
+        agora = (agora + naHora) % SEGUNDOS_NO_DIA;
+        passos -= naHora;
+    }
+    return custo;
+}
+
+/* Simula a plataforma passo a passo até os guindastes voltarem ao
+estado inicial (mesmos progressos, estados e guindastes carregando),
+por no máximo PERIODO_MAXIMO passos. Se voltarem, o movimento se
+repete com esse período enquanto durar o turno, sem corte de carga e
+com espaço de sobra no navio, e os períodos seguintes são saltados de
+uma vez. Não passa da quantidade de passos especificada. Soma o custo
+dos passos dados ao custo e retorna o número deles, incluindo os
+saltados. Função local. */
+static int64_t avancarPeriodos(Plataforma *plataforma, int64_t passos,
+                               double *custo)
+{
+    Bombas *bombas = plataforma->bombas;
+    Guindastes *guindastes = plataforma->guindastes;
+    int totais = guindastes->totais;
+    int progressos[GUINDASTES_NO_PERIODO];
+    bool estados[GUINDASTES_NO_PERIODO];
+    int ativosNoPasso[PERIODO_MAXIMO];
+    memcpy(progressos, guindastes->progressos, totais * sizeof(int));
+    memcpy(estados, guindastes->estados, totais * sizeof(bool));
+    int carregando = guindastes->carregando;
+    int estadoDoNavio = guindastes->estadoDoNavio;
+    int64_t dados = 0;
+    int periodo = 0;
+    bool repetiu = false;
+    while (!repetiu && periodo < PERIODO_MAXIMO && dados < passos)
+    {
+        double fracaoDaTermeletrica;
+        passo(bombas, guindastes, &plataforma->relogio,
+              &fracaoDaTermeletrica, false);
+        *custo += fracaoDaTermeletrica * P_TERMELETRICA *
+                  C_TERMELETRICA / 3600;
+        dados++;
+        // O período só vale se todos os passos dele foram dados no
+        // turno, sem corte e com espaço de sobra no navio.
+        if (!horarioDosGuindastes(horaDoRelogio(plataforma->relogio))
+            || guindastes->limiteDeEnergia < totais
+            || bombas->cortadas != 0
+            || guindastes->estadoDoNavio < 2 * totais + 1)
+        {
+            return dados;
+        }
+        ativosNoPasso[periodo++] = guindastes->ativos;
+        repetiu = guindastes->carregando == carregando
+                  && !memcmp(guindastes->progressos, progressos,
+                             totais * sizeof(int))
+                  && !memcmp(guindastes->estados, estados,
+                             totais * sizeof(bool));
+    }
+    if (!repetiu)
+    {
+        return dados;
+    }
+    // Salta os períodos que cabem no resto do turno, nos passos
+    // restantes e no navio, que deve continuar com espaço de sobra.
+    long agora = segundosDoDia(plataforma->relogio);
+    int horario = (agora + 1) % SEGUNDOS_NO_DIA / 3600;
+    if (!horarioDosGuindastes(horario))
+    {
+        return dados;
+    }
+    long fimDoTurno = horario < 14 ? 14 * 3600L : SEGUNDOS_NO_DIA;
+    int64_t periodos = (fimDoTurno - 1 - agora) / periodo;
+    if (periodos > (passos - dados) / periodo)
+    {
+        periodos = (passos - dados) / periodo;
+    }
+    int barris = estadoDoNavio - guindastes->estadoDoNavio;
+    if (barris > 0
+        && periodos > (guindastes->estadoDoNavio - 2 * totais - 1) / barris)
+    {
+        periodos = (guindastes->estadoDoNavio - 2 * totais - 1) / barris;
+    }
+    if (periodos <= 0)
+    {
+        return dados;
+    }
+    double custoDoSalto = custoPeriodico(plataforma, agora,
+                                         periodos * periodo,
+                                         ativosNoPasso, periodo);
+    if (custoDoSalto < 0)
+    {
+        return dados;
+    }
+    plataforma->relogio += periodos * periodo;
+    guindastes->estadoDoNavio -= periodos * barris;
+    *custo += custoDoSalto;
+    return dados + periodos * periodo;
+}
+
+/* Funciona como passosN, mas salta ciclos inteiros dos guindastes
+(TEMPO_DE_COLETA + TEMPO_DE_CARREGAMENTO segundos), os períodos do
+movimento de uma frota com parte dos guindastes ativos e os períodos em
+que eles não funcionam sem simular cada segundo, sempre que o
+resultado é garantidamente o mesmo. Para depois da quantidade de passos
+especificada ou, se pararComNavioCheio for true, assim que o navio
+atracado ficar cheio. O número de passos dados é colocado em
+passosDados, se não for nulo. Retorna o custo desses passos. */
+double avancarRapidamente(Plataforma *plataforma, int64_t passos,
+                          bool pararComNavioCheio, int64_t *passosDados)
+{
+    Bombas *bombas = plataforma->bombas;
+    Guindastes *guindastes = plataforma->guindastes;
+    int totais = guindastes->totais;
+    double custo = 0;
+    int64_t dados = 0;
+    while (dados < passos
+           && !(pararComNavioCheio && guindastes->estadoDoNavio == 0))
+    {
+        int64_t restantes = passos - dados;
+        long agora = segundosDoDia(plataforma->relogio);
+        int horario = (agora + 1) % SEGUNDOS_NO_DIA / 3600;
+        // Os saltos só valem se nenhum corte de carga estiver em
+        // andamento.
+        bool semCorte = guindastes->limiteDeEnergia >= totais
+                        && bombas->cortadas == 0;
+        long salto = 0;
+        double custoDoSalto = -1;
+        if (semCorte && (!horarioDosGuindastes(horario)
+                         || (guindastes->estadoDoNavio == 0
+                             && !guindastes->preparacao)))
+        {
+            // Sem guindastes funcionando, só o relógio muda até a
+            // próxima hora.
+            salto = passosNaHora(agora);
+            if (salto > restantes)
+            {
+                salto = restantes;
+            }
+            custoDoSalto = custoConstante(plataforma, agora, salto, 0);
+            if (custoDoSalto >= 0)
+            {
+                for (int i = 0; i < totais; i++)
+                {
+                    guindastes->estados[i] = false;
+                }
+                guindastes->ativos = 0;
+            }
+        }
+        else if (semCorte && !guindastes->preparacao
+                 && guindastes->ativosMax >= totais
+                 && guindastes->estadoDoNavio >= 2 * totais + 1)
+        {
+            // Com todos os guindastes ativos, cada ciclo carrega um
+            // barril por guindaste. O navio deve ter espaço de sobra
+            // durante todo o ciclo, e o turno não pode acabar no meio.
+            long fimDoTurno = horario < 14 ? 14 * 3600L : SEGUNDOS_NO_DIA;
+            long ciclos = (fimDoTurno - 1 - agora) / CICLO_DO_GUINDASTE;
+            long ciclosNoNavio = (guindastes->estadoDoNavio - 2 * totais - 1)
+                                 / totais + 1;
+            if (ciclos > ciclosNoNavio)
+            {
+                ciclos = ciclosNoNavio;
+            }
+            if (ciclos > restantes / CICLO_DO_GUINDASTE)
+            {
+                ciclos = restantes / CICLO_DO_GUINDASTE;
+            }
+            salto = ciclos * CICLO_DO_GUINDASTE;
+            if (salto > 0)
+            {
+                custoDoSalto = custoConstante(plataforma, agora, salto,
+                                              totais);
+            }
+            if (custoDoSalto >= 0)
+            {
+                for (int i = 0; i < totais; i++)
+                {
+                    guindastes->estados[i] = true;
+                }
+                guindastes->ativos = totais;
+                guindastes->estadoDoNavio -= ciclos * totais;
+            }
+        }
+        else if (semCorte && !guindastes->preparacao
+                 && guindastes->ativosMax < totais
+                 && totais <= GUINDASTES_NO_PERIODO
+                 && guindastes->estadoDoNavio >= 2 * totais + 1)
+        {
+            // Com parte dos guindastes ativos, procura o período do
+            // movimento e salta os períodos inteiros.
+            dados += avancarPeriodos(plataforma, restantes, &custo);
+            continue;
+        }
+        if (custoDoSalto >= 0)
+        {
+            plataforma->relogio += salto;
+            custo += custoDoSalto;
+            dados += salto;
+            continue;
+        }
+        // Se nenhum salto for possível, simula um passo.
+        double fracaoDaTermeletrica;
+        passo(bombas, guindastes, &plataforma->relogio,
+              &fracaoDaTermeletrica, false);
+        custo += fracaoDaTermeletrica * P_TERMELETRICA *
+                 C_TERMELETRICA / 3600;
+        dados++;
+    }
+    if (passosDados != NULL)
+    {
+        *passosDados = dados;
+    }
+    return custo;
+}
+
+/* Estima quando o navio atracado na plataforma ficará cheio, e quanto
+custará a energia até lá, sem alterar a plataforma. A estimativa é
+colocada no endereço de memória especificado. Retorna false se o navio
+não ficar cheio em LIMITE_DA_ESTIMATIVA passos (por exemplo, sem
+guindastes ativos) ou se não houver memória suficiente. */
+bool estimarNavio(const Plataforma *plataforma,
+                  EstimativaDoNavio *estimativa)
+{
+    // Sem guindastes, o navio nunca fica cheio.
+    if (plataforma->guindastes->estadoDoNavio > 0
+        && plataforma->guindastes->ativosMax == 0)
+    {
+        return false;
+    }
+    // A cópia da plataforma fica em uma região estática de cada
+    // thread, se couber; se não, em uma arena própria.
+    static _Thread_local unsigned char memoria[2048]
+        __attribute__((aligned(ALINHAMENTO_DA_ARENA)));
+    int num_bombas = plataforma->bombas->totais;
+    int num_guindastes = plataforma->guindastes->totais;
+    size_t tamanho = tamanhoDasPlataformas(1, num_bombas, num_guindastes);
+    Arena local;
+    Arena *arena = &local;
+    if (tamanho <= sizeof(memoria))
+    {
+        inicializarArena(&local, memoria, sizeof(memoria));
+    }
+    else if ((arena = CriarArena(tamanho)) == NULL)
+    {
+        return false;
+    }
+    Plataforma *copia = CriarPlataformasNaArena(arena, 1, num_bombas,
+                                                num_guindastes);
+    copiarPlataforma(copia, plataforma);
+    int64_t passos;
+    estimativa->custo = avancarRapidamente(copia, LIMITE_DA_ESTIMATIVA,
+                                           true, &passos);
+    estimativa->segundos = passos;
+    estimativa->relogio = copia->relogio;
+    bool cheio = copia->guindastes->estadoDoNavio == 0;
+    removerArena(arena);
+    return cheio;
+}
@@ -0,0 +1,45 @@
+#ifndef _ESTIMATIVA
+#define _ESTIMATIVA
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "plataforma.h"
+
+/* Número máximo de passos (dez anos) considerados ao estimar quando o
+navio atracado ficará cheio. */
+#define LIMITE_DA_ESTIMATIVA ((int64_t)SEGUNDOS_NO_DIA * DIAS_NO_ANO * 10)
+
+/** Estimativa de quando o navio atracado em uma plataforma ficará
+cheio, e de quanto custará a energia até lá. */
+typedef struct {
+    // Passos (segundos) até o navio ficar cheio.
+    int64_t segundos;
+    // Custo da energia fornecida pela termelétrica até lá, em reais.
+    double custo;
+    // Instante do relógio em que o navio ficará cheio.
+    Relogio relogio;
+} EstimativaDoNavio;
+
+/** Protótipos das funções públicas. */
+
+/* Funciona como passosN, mas salta ciclos inteiros dos guindastes
+(TEMPO_DE_COLETA + TEMPO_DE_CARREGAMENTO segundos), os períodos do
+movimento de uma frota com parte dos guindastes ativos e os períodos em
+que eles não funcionam sem simular cada segundo, sempre que o
+resultado é garantidamente o mesmo. Para depois da quantidade de passos
+especificada ou, se pararComNavioCheio for true, assim que o navio
+atracado ficar cheio. O número de passos dados é colocado em
+passosDados, se não for nulo. Retorna o custo desses passos. */
+double avancarRapidamente(Plataforma *plataforma, int64_t passos,
+                          bool pararComNavioCheio, int64_t *passosDados);
+
+/* Estima quando o navio atracado na plataforma ficará cheio, e quanto
+custará a energia até lá, sem alterar a plataforma. A estimativa é
+colocada no endereço de memória especificado. Retorna false se o navio
+não ficar cheio em LIMITE_DA_ESTIMATIVA passos (por exemplo, sem
+guindastes ativos) ou se não houver memória suficiente. */
+bool estimarNavio(const Plataforma *plataforma,
+                  EstimativaDoNavio *estimativa);
+
+#endif // _ESTIMATIVA
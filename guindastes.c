@@ -9,11 +9,63 @@
  */
 
 #include <stdbool.h>
+#ifndef CONTROLADOR_EMBARCADO
 #include <stdlib.h>
 #include <stdio.h>
+#endif
+#include <string.h>
+
+#if !defined(SEM_SIMD) && defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 #include "guindastes.h"
 
+/* Inicializa um grupo de guindastes em um bloco de memória com o
+tamanho dado por tamanhoDosGuindastes. As listas de progressos e de
+estados ficam no mesmo bloco, logo após a estrutura. A versão de
+atualizarGuindastes é escolhida pelo tamanho do grupo. Função local. */
+static Guindastes *inicializarGuindastes(void *memoria,
+                                         int num_guindastes)
+{
+    Guindastes *guindastes = memoria;
+    unsigned char *listas = (unsigned char *)memoria
+                            + ALINHAR_NA_ARENA(sizeof(Guindastes));
+    guindastes->progressos = (int *)listas;
+    guindastes->estados = (bool *)(listas
+        + ALINHAR_NA_ARENA(num_guindastes * sizeof(int)));
+    for (int i = 0; i < num_guindastes; i++)
+    {
+        guindastes->progressos[i] = -TEMPO_DE_COLETA;
+        guindastes->estados[i] = false;
+    }
+    // Inicializa o restante das variáveis.
+    guindastes->totais = num_guindastes;
+    guindastes->ativos = 0;
+    guindastes->ativosMax = num_guindastes;
+    guindastes->limiteDeEnergia = num_guindastes;
+    guindastes->preparacao = false;
+    guindastes->barrisPreparados = 0;
+    guindastes->carregando = 0;
+    guindastes->estadoDoNavio = 0;
+    // Grupos pequenos não compensam o custo da versão vetorial.
+    guindastes->kernel = num_guindastes >= GUINDASTES_DO_KERNEL_VETORIAL
+                         ? kernelGenericoDosGuindastes
+                         : kernelEscalarDosGuindastes;
+    return guindastes;
+}
+
+/* Retorna o tamanho, em bytes, de um grupo de guindastes com o
+número de guindastes especificado, incluindo as listas de progressos
+e de estados. */
+size_t tamanhoDosGuindastes(int num_guindastes)
+{
+    return ALINHAR_NA_ARENA(sizeof(Guindastes))
+           + ALINHAR_NA_ARENA(num_guindastes * sizeof(int))
+           + ALINHAR_NA_ARENA(num_guindastes * sizeof(bool));
+}
+
+#ifndef CONTROLADOR_EMBARCADO
 /* Cria e inicializa um grupo de guindastes. No início, todos os
 guindastes estão inativos, mas prontos para carregar um barril. */
 Guindastes *CriarGuindastes(int num_guindastes)
@@ -24,35 +76,36 @@ Guindastes *CriarGuindastes(int num_guindastes)
     {
         return NULL;
     }
-    // Tenta reservar espaço para um grupo de guindastes. Se isso
-    // falhar, retorn um apontador nulo.
-    Guindastes *guindastes = malloc(sizeof(Guindastes));
-    if (guindastes == NULL)
+    // Tenta reservar espaço para um grupo de guindastes e suas listas
+    // de estados e progressos, de uma só vez. Se isso falhar, retorna
+    // um apontador nulo.
+    void *memoria = malloc(tamanhoDosGuindastes(num_guindastes));
+    if (memoria == NULL)
     {
         return NULL;
     }
-    // Tenta criar listas para guardar os estados e os progressos.
-    // Se isso falhar, retorna um apontador nulo.
-    guindastes->progressos = malloc(num_guindastes * sizeof(int));
-    guindastes->estados = malloc(num_guindastes * sizeof(bool));
-    if (guindastes->progressos == NULL || guindastes->estados == NULL)
+    return inicializarGuindastes(memoria, num_guindastes);
+}
+#endif
+
+/* Funciona como CriarGuindastes, mas reserva o grupo de guindastes em
+uma arena. Retorna um apontador nulo se não houver espaço na arena. */
+Guindastes *CriarGuindastesNaArena(Arena *arena, int num_guindastes)
+{
+    if (num_guindastes < 1)
     {
         return NULL;
     }
-    for (int i = 0; i < num_guindastes; i++)
+    void *memoria = reservarNaArena(arena,
+                                    tamanhoDosGuindastes(num_guindastes));
+    if (memoria == NULL)
     {
-        guindastes->progressos[i] = -TEMPO_DE_COLETA;
-        guindastes->estados[i] = false;
+        return NULL;
     }
-    // Inicializa o restante das variáveis.
-    guindastes->totais = num_guindastes;
-    guindastes->ativos = 0;
-    guindastes->ativosMax = num_guindastes;
-    guindastes->carregando = 0;
-    guindastes->estadoDoNavio = 0;
-    return guindastes;
+    return inicializarGuindastes(memoria, num_guindastes);
 }
 
+#ifndef CONTROLADOR_EMBARCADO
 /* Mostra ATIVO se o estado for verdadeiro, INATIVO se for
 falso. Utilizado por estadoDosGuindastes. Função local. */
 static void mostrarEstadoDoGuindaste(bool estado)
@@ -74,6 +127,12 @@ void estadoDosGuindastes(Guindastes *guindastes)
     printf("Guindastes totais: %d\n", guindastes->totais);
     printf("Guindastes ativos: %d\n", guindastes->ativos);
     printf("Guindastes ativos (max): %d\n", guindastes->ativosMax);
+    printf("Guindastes permitidos pela energia: %d\n",
+           guindastes->limiteDeEnergia);
+    if (guindastes->preparacao || guindastes->barrisPreparados > 0)
+    {
+        printf("Barris preparados: %d\n", guindastes->barrisPreparados);
+    }
     printf("Guindastes carregando: %d\n", guindastes->carregando);
     printf("  Guindastes: estado (progresso)\n");
     for (int i = 0; i < guindastes->totais; i++)
@@ -84,14 +143,15 @@ void estadoDosGuindastes(Guindastes *guindastes)
     }
     printf("Estado do navio: %d\n", guindastes->estadoDoNavio);
 }
+#endif
 
 /* Desativa todos os guindastes. Função local. */
-static void desativarTodosOsGuindastes(Guindastes *guindastes)
+static inline __attribute__((always_inline))
+void desativarTodosOsGuindastes(bool *estados, int totais)
 {
-    guindastes->ativos = 0;
-    for (int i = 0; i < guindastes->totais; i ++)
+    for (int i = 0; i < totais; i ++)
     {
-        guindastes->estados[i] = false;
+        estados[i] = false;
     }
 }
 
@@ -99,107 +159,442 @@ static void desativarTodosOsGuindastes(Guindastes *guindastes)
 guindastes, atualizando ao mesmo tempo o estado de cada guindaste.
 Tem preferência por desativar guindastes com menor progresso, e
 reativar guindastes com maior progresso, economizando energia a longo
-prazo. Função local. */
-static void alterarGuindastesAtivos(Guindastes *guindastes)
+prazo. Retorna o novo número de guindastes ativos. Função local. */
+static inline __attribute__((always_inline))
+int alterarGuindastesAtivos(const int *progressos, bool *estados,
+                            int totais, int ativosMax)
 {
+    // Se todos os guindastes devem ficar ativos, não é preciso
+    // escolher quais reativar.
+    if (ativosMax == totais)
+    {
+        for (int i = 0; i < totais; i++)
+        {
+            estados[i] = true;
+        }
+        return totais;
+    }
     // Primeiro, desativa todos os guindastes.
-    desativarTodosOsGuindastes(guindastes);
+    desativarTodosOsGuindastes(estados, totais);
+    int ativos = 0;
     // Então, reativa guindaste até o número de guindastes ativos
     // ser igual ao número de guindastes ativos máximo.
-    while (guindastes->ativos != guindastes->ativosMax)
+    while (ativos != ativosMax)
     {
-        guindastes->ativos++;
-        int maiorIndice, maiorProgresso;
+        ativos++;
+        int maiorIndice = 0;
+        int maiorProgresso = progressos[0];
         // Acha um guindaste inativo e guarda seu índice e progresso.
-        for (int i = 0; i < guindastes->totais; i++)
+        for (int i = 0; i < totais; i++)
         {
-            if (!guindastes->estados[i])
+            if (!estados[i])
             {
                 maiorIndice = i;
-                maiorProgresso = guindastes->progressos[i];
+                maiorProgresso = progressos[i];
                 break;
             }
         }
         // Então, tenta achar o guindaste inativo com maior progresso.
-        for (int i = maiorIndice + 1; i < guindastes->totais; i++)
+        for (int i = maiorIndice + 1; i < totais; i++)
         {
-            if (!guindastes->estados[i]
-                && guindastes->progressos[i] > maiorProgresso)
+            if (!estados[i] && progressos[i] > maiorProgresso)
             {
                 maiorIndice = i;
-                maiorProgresso = guindastes->progressos[i];
+                maiorProgresso = progressos[i];
             }
         }
         // Finalmente, ativa o guindaste com maior progresso encontrado.
-        guindastes->estados[maiorIndice] = true;
+        estados[maiorIndice] = true;
     }
+    return ativos;
 }
 
-/* Avança o estado de todos os componentes do grupo de guindastes
-em um minuto. A alteração dos estados depende do horário, já que os
-guindastes não funcionam 24 h por dia. O horário é dado em horas. */
-bool atualizarGuindastes(Guindastes *guindastes, int horario)
+/* Retorna true se o horário, em horas, está dentro dos horários de
+funcionamento dos guindastes (das 6 h às 14 h e das 18 h às 24 h). */
+bool horarioDosGuindastes(int horario)
 {
-    // Se o horário estiver fora dos horários de funcionamento dos
-    // guindastes ou não houver um navio atracado, desativa todos
-    // eles.
-    if (guindastes->estadoDoNavio == 0
-        || horario < 6
-        || (horario >= 14 && horario < 18)
-        || horario >= 24)
-    {
-        desativarTodosOsGuindastes(guindastes);
-        return guindastes->estadoDoNavio != 0;
-    }
-    // Se o horário estiver dentro dos horários de funcionamento dos
-    // guindastes e houver um navio atracado, atualiza o número de
-    // guindastes ativos, para que seja igual ao número máximo de
-    // guindastes ativos.
-    alterarGuindastesAtivos(guindastes);
-    // Atualiza a posição de cada guindaste.
-    for (int i = 0; i < guindastes->totais; i++)
+    return horario >= 6
+           && (horario < 14 || horario >= 18)
+           && horario < 24;
+}
+
+/* Atualiza a posição dos guindastes de índice inicio até fim - 1, um
+por vez, em ordem. É a definição de referência do movimento dos
+guindastes. Função local. */
+static inline __attribute__((always_inline))
+void avancarPosicoesEscalar(int *progressos, bool *estados, int inicio,
+                            int fim, int *ativos, int *carregando,
+                            int *estadoDoNavio)
+{
+    for (int i = inicio; i < fim; i++)
     {
         // Se um guindaste está inativo, ele continua parado.
-        if (!guindastes->estados[i])
+        if (!estados[i])
         {
             continue;
         }
         // Se o guindaste tiver chegado na posição original, decide
         // se vai carregar um barril ou ficar parado.
-        if (guindastes->progressos[i] == 0)
+        if (progressos[i] == 0)
         {
             // Se o número de guindastes carregando barris for o
             // suficiente para encher o barco, o guindaste fica
             // parado.
-            if (guindastes->carregando >= guindastes->estadoDoNavio)
+            if (*carregando >= *estadoDoNavio)
             {
-                guindastes->ativos--;
-                guindastes->estados[i] = false;
+                (*ativos)--;
+                estados[i] = false;
                 continue;
             }
             // Se não, o guindaste começa a carregar um barril.
             else
             {
-                guindastes->carregando++;
+                (*carregando)++;
             }
         }
         // Se o guindaste tiver terminado de carregar um barril,
         // diminui o número de guindastes carregando barris e faz
         // eles começar a coletar outro.
-        else if (guindastes->progressos[i] == TEMPO_DE_CARREGAMENTO - 1)
+        else if (progressos[i] == TEMPO_DE_CARREGAMENTO - 1)
         {
-            guindastes->carregando--;
-            guindastes->progressos[i] = -1 - TEMPO_DE_COLETA;
-            guindastes->estadoDoNavio--;
+            (*carregando)--;
+            progressos[i] = -1 - TEMPO_DE_COLETA;
+            (*estadoDoNavio)--;
         }
         // A posição do guindaste é avançanda em um passo.
         /** Em um sistema real, a posição do guindaste poderia ser
         determinada empiricamente, em vez de ser simulada. */
-        guindastes->progressos[i]++;
+        progressos[i]++;
     }
+}
+
+/** Na versão vetorial, cada guindaste é classificado por máscaras, sem
+desvios: inativo, chegando à posição original (candidato a carregar
+um barril), terminando de carregar, ou em movimento. Cada guindaste
+que termina de carregar diminui tanto o número de guindastes
+carregando quanto a capacidade do navio, então a condição
+carregando >= estadoDoNavio do k-ésimo candidato do passo (contado a
+partir de 0) se reduz a carregando + k >= estadoDoNavio, com os
+valores do início do passo. O índice k de cada candidato vem de uma
+soma de prefixos das máscaras, e os totais só são somados no fim. O
+resultado é idêntico ao de avancarPosicoesEscalar. */
+
+#if !defined(SEM_SIMD) && defined(__AVX2__)
+/* Atualiza os guindastes em blocos de 8, com instruções AVX2, e
+retorna o número de guindastes atualizados. Os contadores recebem o
+número de candidatos admitidos, negados e de guindastes que terminaram
+de carregar. Função local. */
+static inline __attribute__((always_inline))
+int avancarBlocosAVX2(int *progressos, bool *estados, int totais,
+                      int limite, int *admitidos, int *negados,
+                      int *terminados)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i carga = _mm256_set1_epi32(TEMPO_DE_CARREGAMENTO - 1);
+    const __m256i coleta = _mm256_set1_epi32(-TEMPO_DE_COLETA);
+    const __m256i vLimite = _mm256_set1_epi32(limite);
+    __m256i base = _mm256_set1_epi32(*admitidos + *negados);
+    __m256i somaAdmitidos = zero, somaNegados = zero;
+    __m256i somaTerminados = zero;
+    int i = 0;
+    for (; i + 8 <= totais; i += 8)
+    {
+        __m256i progresso = _mm256_loadu_si256((__m256i *)(progressos + i));
+        __m256i ativo = _mm256_cmpgt_epi32(_mm256_cvtepu8_epi32(
+            _mm_loadl_epi64((__m128i *)(estados + i))), zero);
+        __m256i candidato = _mm256_and_si256(ativo,
+            _mm256_cmpeq_epi32(progresso, zero));
+        __m256i terminando = _mm256_and_si256(ativo,
+            _mm256_cmpeq_epi32(progresso, carga));
+        // Soma de prefixos inclusiva dos candidatos, primeiro em cada
+        // metade do registrador e depois levando o total da primeira
+        // metade para a segunda.
+        __m256i um = _mm256_sub_epi32(zero, candidato);
+        __m256i prefixo = _mm256_add_epi32(um, _mm256_slli_si256(um, 4));
+        prefixo = _mm256_add_epi32(prefixo, _mm256_slli_si256(prefixo, 8));
+        prefixo = _mm256_add_epi32(prefixo, _mm256_shuffle_epi32(
+            _mm256_permute2x128_si256(prefixo, prefixo, 0x08), 0xFF));
+        __m256i indice = _mm256_add_epi32(base,
+                                          _mm256_sub_epi32(prefixo, um));
+        __m256i admitido = _mm256_and_si256(candidato,
+            _mm256_cmpgt_epi32(vLimite, indice));
+        __m256i negado = _mm256_andnot_si256(admitido, candidato);
+        // Guindastes ativos e não negados avançam um passo; os que
+        // terminam de carregar voltam ao início da coleta.
+        __m256i avancando = _mm256_andnot_si256(negado, ativo);
+        progresso = _mm256_sub_epi32(progresso, avancando);
+        progresso = _mm256_blendv_epi8(progresso, coleta, terminando);
+        _mm256_storeu_si256((__m256i *)(progressos + i), progresso);
+        // Converte os novos estados de volta para bool.
+        __m256i novo = _mm256_sub_epi32(zero, avancando);
+        novo = _mm256_packus_epi16(_mm256_packs_epi32(novo, novo), zero);
+        int baixo = _mm_cvtsi128_si32(_mm256_castsi256_si128(novo));
+        int alto = _mm_cvtsi128_si32(_mm256_extracti128_si256(novo, 1));
+        memcpy(estados + i, &baixo, 4);
+        memcpy(estados + i + 4, &alto, 4);
+        // O total de candidatos do bloco está no último elemento da
+        // soma de prefixos.
+        base = _mm256_add_epi32(base, _mm256_permutevar8x32_epi32(
+            prefixo, _mm256_set1_epi32(7)));
+        somaAdmitidos = _mm256_sub_epi32(somaAdmitidos, admitido);
+        somaNegados = _mm256_sub_epi32(somaNegados, negado);
+        somaTerminados = _mm256_sub_epi32(somaTerminados, terminando);
+    }
+    int parcial[8];
+    _mm256_storeu_si256((__m256i *)parcial, somaAdmitidos);
+    for (int j = 0; j < 8; j++) *admitidos += parcial[j];
+    _mm256_storeu_si256((__m256i *)parcial, somaNegados);
+    for (int j = 0; j < 8; j++) *negados += parcial[j];
+    _mm256_storeu_si256((__m256i *)parcial, somaTerminados);
+    for (int j = 0; j < 8; j++) *terminados += parcial[j];
+    return i;
+}
+#endif
+
+#if !defined(SEM_SIMD) && defined(__SSE2__)
+/* Atualiza os guindastes a partir do índice inicio em blocos de 4,
+com instruções SSE2, e retorna o índice do primeiro guindaste não
+atualizado. Os contadores funcionam como em avancarBlocosAVX2. Função
+local. */
+static inline __attribute__((always_inline))
+int avancarBlocosSSE2(int *progressos, bool *estados, int inicio,
+                      int totais, int limite, int *admitidos,
+                      int *negados, int *terminados)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i carga = _mm_set1_epi32(TEMPO_DE_CARREGAMENTO - 1);
+    const __m128i coleta = _mm_set1_epi32(-TEMPO_DE_COLETA);
+    const __m128i vLimite = _mm_set1_epi32(limite);
+    __m128i base = _mm_set1_epi32(*admitidos + *negados);
+    __m128i somaAdmitidos = zero, somaNegados = zero;
+    __m128i somaTerminados = zero;
+    int i = inicio;
+    for (; i + 4 <= totais; i += 4)
+    {
+        __m128i progresso = _mm_loadu_si128((__m128i *)(progressos + i));
+        int bytes;
+        memcpy(&bytes, estados + i, 4);
+        __m128i ativo = _mm_cvtsi32_si128(bytes);
+        ativo = _mm_unpacklo_epi16(_mm_unpacklo_epi8(ativo, zero), zero);
+        ativo = _mm_cmpgt_epi32(ativo, zero);
+        __m128i candidato = _mm_and_si128(ativo,
+                                          _mm_cmpeq_epi32(progresso, zero));
+        __m128i terminando = _mm_and_si128(ativo,
+                                           _mm_cmpeq_epi32(progresso, carga));
+        // Soma de prefixos inclusiva dos candidatos.
+        __m128i um = _mm_sub_epi32(zero, candidato);
+        __m128i prefixo = _mm_add_epi32(um, _mm_slli_si128(um, 4));
+        prefixo = _mm_add_epi32(prefixo, _mm_slli_si128(prefixo, 8));
+        __m128i indice = _mm_add_epi32(base, _mm_sub_epi32(prefixo, um));
+        __m128i admitido = _mm_and_si128(candidato,
+                                         _mm_cmpgt_epi32(vLimite, indice));
+        __m128i negado = _mm_andnot_si128(admitido, candidato);
+        // Guindastes ativos e não negados avançam um passo; os que
+        // terminam de carregar voltam ao início da coleta.
+        __m128i avancando = _mm_andnot_si128(negado, ativo);
+        progresso = _mm_sub_epi32(progresso, avancando);
+        progresso = _mm_or_si128(_mm_and_si128(terminando, coleta),
+                                 _mm_andnot_si128(terminando, progresso));
+        _mm_storeu_si128((__m128i *)(progressos + i), progresso);
+        // Converte os novos estados de volta para bool.
+        __m128i novo = _mm_sub_epi32(zero, avancando);
+        novo = _mm_packus_epi16(_mm_packs_epi32(novo, zero), zero);
+        bytes = _mm_cvtsi128_si32(novo);
+        memcpy(estados + i, &bytes, 4);
+        // O total de candidatos do bloco está no último elemento da
+        // soma de prefixos.
+        base = _mm_add_epi32(base, _mm_shuffle_epi32(prefixo, 0xFF));
+        somaAdmitidos = _mm_sub_epi32(somaAdmitidos, admitido);
+        somaNegados = _mm_sub_epi32(somaNegados, negado);
+        somaTerminados = _mm_sub_epi32(somaTerminados, terminando);
+    }
+    int parcial[4];
+    _mm_storeu_si128((__m128i *)parcial, somaAdmitidos);
+    *admitidos += parcial[0] + parcial[1] + parcial[2] + parcial[3];
+    _mm_storeu_si128((__m128i *)parcial, somaNegados);
+    *negados += parcial[0] + parcial[1] + parcial[2] + parcial[3];
+    _mm_storeu_si128((__m128i *)parcial, somaTerminados);
+    *terminados += parcial[0] + parcial[1] + parcial[2] + parcial[3];
+    return i;
+}
+#endif
+
+/* Funciona como avancarPosicoesEscalar, mas para o modo de
+preparação: um guindaste que coletou um barril e não tem espaço no
+navio o deixa preparado e volta a coletar, e um guindaste que termina
+de carregar um barril pega um preparado, sem precisar coletá-lo.
+Função local. */
+static inline __attribute__((always_inline))
+void avancarPosicoesComPreparacao(int *progressos, bool *estados,
+                                  int totais, int *ativos,
+                                  int *carregando, int *estadoDoNavio,
+                                  int *barrisPreparados)
+{
+    for (int i = 0; i < totais; i++)
+    {
+        if (!estados[i])
+        {
+            continue;
+        }
+        if (progressos[i] == 0)
+        {
+            if (*carregando >= *estadoDoNavio)
+            {
+                // Sem espaço no navio, o barril fica preparado, se
+                // houver espaço no convés; se não, o guindaste para.
+                if (*barrisPreparados >= CAPACIDADE_DA_PREPARACAO)
+                {
+                    (*ativos)--;
+                    estados[i] = false;
+                    continue;
+                }
+                (*barrisPreparados)++;
+                progressos[i] = -1 - TEMPO_DE_COLETA;
+            }
+            else
+            {
+                (*carregando)++;
+            }
+        }
+        else if (progressos[i] == TEMPO_DE_CARREGAMENTO - 1)
+        {
+            (*carregando)--;
+            (*estadoDoNavio)--;
+            // Se houver um barril preparado, o guindaste o pega em
+            // vez de coletar outro.
+            if (*barrisPreparados > 0)
+            {
+                (*barrisPreparados)--;
+                progressos[i] = -1;
+            }
+            else
+            {
+                progressos[i] = -1 - TEMPO_DE_COLETA;
+            }
+        }
+        progressos[i]++;
+    }
+}
+
+/* Atualiza a posição de todos os guindastes, em blocos de 8 (AVX2) ou
+4 (SSE2) guindastes, quando o compilador tiver essas instruções
+disponíveis. Os guindastes que sobram são atualizados por
+avancarPosicoesEscalar. Compilar com -DSEM_SIMD desativa as instruções
+vetoriais. Função local. */
+static inline __attribute__((always_inline))
+void avancarPosicoesVetorial(int *progressos, bool *estados, int totais,
+                             int *ativos, int *carregando,
+                             int *estadoDoNavio)
+{
+    int i = 0;
+#if !defined(SEM_SIMD) && defined(__SSE2__)
+    int limite = *estadoDoNavio - *carregando;
+    int admitidos = 0, negados = 0, terminados = 0;
+#if defined(__AVX2__)
+    i = avancarBlocosAVX2(progressos, estados, totais, limite,
+                          &admitidos, &negados, &terminados);
+#endif
+    i = avancarBlocosSSE2(progressos, estados, i, totais, limite,
+                          &admitidos, &negados, &terminados);
+    *ativos -= negados;
+    *carregando += admitidos - terminados;
+    *estadoDoNavio -= terminados;
+#endif
+    avancarPosicoesEscalar(progressos, estados, i, totais, ativos,
+                           carregando, estadoDoNavio);
+}
+
+/* Núcleo comum às versões de atualizarGuindastes. Se vetorial for
+true, as posições são atualizadas por avancarPosicoesVetorial; se não,
+por avancarPosicoesEscalar. Função local. */
+static inline __attribute__((always_inline))
+bool avancarGuindastes(Guindastes *guindastes, int horario, bool vetorial)
+{
+    int *progressos = guindastes->progressos;
+    bool *estados = guindastes->estados;
+    int totais = guindastes->totais;
+    int carregando = guindastes->carregando;
+    int estadoDoNavio = guindastes->estadoDoNavio;
+    // Se o horário estiver fora dos horários de funcionamento dos
+    // guindastes ou não houver um navio atracado (e os guindastes não
+    // estiverem preparando barris), desativa todos eles.
+    if ((estadoDoNavio == 0 && !guindastes->preparacao)
+        || !horarioDosGuindastes(horario))
+    {
+        desativarTodosOsGuindastes(estados, totais);
+        guindastes->ativos = 0;
+        return estadoDoNavio != 0;
+    }
+    // Se o horário estiver dentro dos horários de funcionamento dos
+    // guindastes e houver um navio atracado, atualiza o número de
+    // guindastes ativos, para que seja igual ao número máximo de
+    // guindastes ativos, respeitando o limite imposto pela energia.
+    int ativosMax = guindastes->ativosMax;
+    if (guindastes->limiteDeEnergia < ativosMax)
+    {
+        ativosMax = guindastes->limiteDeEnergia;
+    }
+    int ativos = alterarGuindastesAtivos(progressos, estados, totais,
+                                         ativosMax);
+    // Atualiza a posição de cada guindaste.
+    if (guindastes->preparacao)
+    {
+        bool haviaNavio = estadoDoNavio != 0;
+        avancarPosicoesComPreparacao(progressos, estados, totais, &ativos,
+                                     &carregando, &estadoDoNavio,
+                                     &guindastes->barrisPreparados);
+        guindastes->ativos = ativos;
+        guindastes->carregando = carregando;
+        guindastes->estadoDoNavio = estadoDoNavio;
+        return haviaNavio;
+    }
+    else if (vetorial)
+    {
+        avancarPosicoesVetorial(progressos, estados, totais, &ativos,
+                                &carregando, &estadoDoNavio);
+    }
+    else
+    {
+        avancarPosicoesEscalar(progressos, estados, 0, totais, &ativos,
+                               &carregando, &estadoDoNavio);
+    }
+    guindastes->ativos = ativos;
+    guindastes->carregando = carregando;
+    guindastes->estadoDoNavio = estadoDoNavio;
     return true;
 }
 
+/* Versão genérica de atualizarGuindastes, que funciona com qualquer
+número de guindastes. */
+bool kernelGenericoDosGuindastes(Guindastes *guindastes, int horario)
+{
+    return avancarGuindastes(guindastes, horario, true);
+}
+
+/* Funciona como kernelGenericoDosGuindastes, mas sem instruções
+vetoriais. Serve como referência para as outras versões, que devem
+chegar exatamente ao mesmo estado. */
+bool kernelEscalarDosGuindastes(Guindastes *guindastes, int horario)
+{
+    return avancarGuindastes(guindastes, horario, false);
+}
+
+/* Avança o estado de todos os componentes do grupo de guindastes
+em um minuto. A alteração dos estados depende do horário, já que os
+guindastes não funcionam 24 h por dia. O horário é dado em horas. */
+bool atualizarGuindastes(Guindastes *guindastes, int horario)
+{
+    // A versão escolhida na criação do grupo faz o trabalho.
+    return guindastes->kernel(guindastes, horario);
+}
+
+/* Ativa ou desativa o modo de preparação de um grupo de guindastes.
+Ao desativar, os barris já preparados ficam esperando no convés. */
+void alterarPreparacao(Guindastes *guindastes, bool preparacao)
+{
+    guindastes->preparacao = preparacao;
+}
+
 /* Atualiza o valor da capacidade do navio de um grupo de guindastes
 quando um novo navio é atracado. A capacidade é um valor inteiro,
 e representa a quantidade de barris que o novo navio ainda pode
@@ -214,13 +609,13 @@ bool atualizarNavio(Guindastes *guindastes, int capacidade)
     return false;
 }
 
-/* Remove o grupo de guindastes da memória. */
+#ifndef CONTROLADOR_EMBARCADO
+/* Remove o grupo de guindastes da memória. Não deve ser usada com
+grupos criados em uma arena. */
 void removerGuindastes(Guindastes *guindastes)
 {
-    if (guindastes != NULL)
-    {
-        free(guindastes->progressos);
-        free(guindastes->estados);
-    }
+    // As listas de progressos e estados fazem parte do mesmo bloco de
+    // memória.
     free(guindastes);
 }
+#endif
@@ -2,6 +2,9 @@
 #define _GUINDASTES
 
 #include <stdbool.h>
+#include <stddef.h>
+
+#include "arena.h"
 
 /* Número de guindastes, definido pelo desafio. */
 #define NUM_GUINDASTES 10
@@ -17,12 +20,28 @@ ele ser coletado, em segundos. Definido pela equipe. */
 #define TEMPO_DE_CARREGAMENTO 17
 /* Capacidade do navio, determinado pela equipe. */
 #define CAPACIDADE_DO_NAVIO 203349
+/* Número máximo de barris que podem ficar preparados no convés,
+esperando um navio, no modo de preparação. Definido pela equipe. */
+#define CAPACIDADE_DA_PREPARACAO 500
+/* Tempo entre a partida de um navio cheio e a atracação do próximo,
+em segundos. Definido pela equipe. */
+#define TEMPO_DE_TROCA 3600
+/* Número mínimo de guindastes a partir do qual o grupo usa a versão
+vetorial de atualizarGuindastes. Com menos guindastes, a versão
+escalar é mais rápida. Medido com 'make bench'. */
+#define GUINDASTES_DO_KERNEL_VETORIAL 64
+
+typedef struct Guindastes Guindastes;
+
+/* Tipo das funções que avançam o estado de um grupo de guindastes em
+um passo, usadas por atualizarGuindastes. */
+typedef bool (*KernelDosGuindastes)(Guindastes *guindastes, int horario);
 
 /** Representação programática de um grupo de guindastes. Em um
 sistema real, os valores da variável estados (dos guindastes) seriam
 usados para controlar os respectivos dispositivos mecânicos, através
 de uma interface controlador -> dispositivo. */
-typedef struct {
+struct Guindastes {
     // Número de guindastes totais.
     int totais;
     // Número de guindastes ativos.
@@ -30,6 +49,9 @@ typedef struct {
     // Número máximo de guindastes ativos, definido pelo suprimento de
     // energia.
     int ativosMax;
+    // Número máximo de guindastes ativos, definido pela política de
+    // corte de carga quando a energia disponível é limitada.
+    int limiteDeEnergia;
     // Número de guindastes que estão, no momento, carregando um
     // barril no navio.
     int carregando;
@@ -38,6 +60,12 @@ typedef struct {
     // Quando positivo, indica o número de barris que o navio atracado
     // ainda pode comportar.
     int estadoDoNavio;
+    // true se os guindastes continuam coletando barris quando não há
+    // espaço no navio (no fim do carregamento ou na troca de navios),
+    // deixando-os preparados para o próximo navio.
+    bool preparacao;
+    // Número de barris preparados, esperando um navio.
+    int barrisPreparados;
     // Número que representa o progresso de um determinado guindaste,
     // no processo de carregamento de um barril ou coleta de um novo
     // barril. Quando negativo, o guindaste está procurando um novo
@@ -47,18 +75,37 @@ typedef struct {
     // Lista que representa o estado de cada guindaste, onde
     // true = ativo, false = inativo.
     bool *estados;
-} Guindastes;
+    // Versão de atualizarGuindastes usada pelo grupo.
+    KernelDosGuindastes kernel;
+};
 
 /** Protótipos das funções públicas, utilizadas pelo controlador
 principal. */
 
+#ifndef CONTROLADOR_EMBARCADO
 /* Cria e inicializa um grupo de guindastes. No início, todos os
 guindastes estão inativos e prontos para carregar um barril. */
 Guindastes *CriarGuindastes(int num_guindastes);
+#endif
+
+/* Funciona como CriarGuindastes, mas reserva o grupo de guindastes em
+uma arena. Retorna um apontador nulo se não houver espaço na arena. */
+Guindastes *CriarGuindastesNaArena(Arena *arena, int num_guindastes);
+
+/* Retorna o tamanho, em bytes, de um grupo de guindastes com o
+número de guindastes especificado, incluindo as listas de progressos
+e de estados. */
+size_t tamanhoDosGuindastes(int num_guindastes);
 
+#ifndef CONTROLADOR_EMBARCADO
 /* Mostra o estado de todos os componentes de um grupo de guindastes
 no terminal. */
 void estadoDosGuindastes(Guindastes *guindastes);
+#endif
+
+/* Retorna true se o horário, em horas, está dentro dos horários de
+funcionamento dos guindastes (das 6 h às 14 h e das 18 h às 24 h). */
+bool horarioDosGuindastes(int horario);
 
 /* Avança o estado de todos os componentes do grupo de guindastes
 em um minuto. A alteração dos estados depende do horário, já que os
@@ -68,6 +115,19 @@ carregamento, false se não houver um navio atracado ou se o navio
 atracado estiver cheio. */
 bool atualizarGuindastes(Guindastes *guindastes, int horario);
 
+/* Versão genérica de atualizarGuindastes, que funciona com qualquer
+número de guindastes. */
+bool kernelGenericoDosGuindastes(Guindastes *guindastes, int horario);
+
+/* Funciona como kernelGenericoDosGuindastes, mas sem instruções
+vetoriais. Serve como referência para as outras versões, que devem
+chegar exatamente ao mesmo estado. */
+bool kernelEscalarDosGuindastes(Guindastes *guindastes, int horario);
+
+/* Ativa ou desativa o modo de preparação de um grupo de guindastes.
+Ao desativar, os barris já preparados ficam esperando no convés. */
+void alterarPreparacao(Guindastes *guindastes, bool preparacao);
+
 /* Tenta atualizar o valor da capacidade do navio de um grupo de
 guindastes quando um novo navio cehga. A capacidade é um valor
 inteiro, e representa a quantidade de barris que o novo navio ainda
@@ -75,7 +135,10 @@ pode comportar. Retorna true se o novo navio pôde ser atracado, falso
 se não, ou seja, quando outro navio ainda estava no porto. */
 bool atualizarNavio(Guindastes *guindastes, int capacidade);
 
-/* Remove o grupo de guindastes da memória. */
+#ifndef CONTROLADOR_EMBARCADO
+/* Remove o grupo de guindastes da memória. Não deve ser usada com
+grupos criados em uma arena. */
 void removerGuindastes(Guindastes *guindastes);
+#endif
 
 #endif // _GUINDASTES
@@ -0,0 +1,1050 @@
+/** Emite comandos para os módulos de controle das bombas e dos
+ *  guindastes. Faz isso baseado em cálculos de consumo de energia.
+ *  Conta com um modo interativo, que permite simular situações reais
+ *  de ativação e desativação de componentes, carregamento de navios
+ *  e o modo de emergência das bombas.
+ *  O modo interativo pode ser acesso abrindo o programa sem nenhum
+ *  argumento ou com o argumento opcional -t, que permite escolher um
+ *  horário inicial diferente do padrão (12:00).
+ *  Além disso, pode ser aberto no modo custo, que calcula o custo
+ *  diário e mensal de operação da plataforma, de acordo com as
+ *  especificaçes do desafio.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <signal.h>
+
+#include "energia.h"
+#include "rede.h"
+#include "paralelo.h"
+#include "diario.h"
+#include "estimativa.h"
+#include "previsao.h"
+#include "sensibilidade.h"
+#include "cache.h"
+
+/** Protótipos das funções locais. */
+
+/* Solicita um número do usuário dentro de um limite. */
+int getNum(int minimo, int maximo);
+
+/* Retorna true se str for uma string numérica, false se não. */
+bool strNumerica(char *str);
+
+/* Mostra as instruções de uso do programa e do modo interativo,
+respectivamente. */
+void ajudaDoPrograma(void);
+void ajudoDoModoInterativo(void);
+
+/* Refaz um comando do modo interativo registrado no diário, sem
+mostrar nada no terminal. Retorna o custo do comando. */
+double refazerComando(char comando, int argumento, Sessao *sessao);
+
+/* Registram um comando e um ponto de recuperação, respectivamente, no
+diário da sessão. Se o registro falhar, avisam o usuário e fecham o
+diário, que passa a ser nulo. */
+void registrarNoDiario(Diario **diario, char comando, int argumento);
+void registrarPontoNoDiario(Diario **diario, const Sessao *sessao);
+
+/* Mostra o custo de cada mês do calendário, e os dias de menor e de
+maior custo, de uma simulação que começa no início do relógio. */
+void mostrarResumo(const double *custosDiarios, int dias,
+                   const double *custosMensais, int meses);
+
+/* Arquivo em que o modo interativo grava a previsão da demanda. */
+#define ARQUIVO_DA_PREVISAO "previsao.csv"
+
+int main(int argc, char **argv)
+{
+    // Variáveis que dependem dos argumentos.
+    Relogio relogio = relogioDoHorario(12, 0, 0);
+    // Arquivo do diário da sessão interativa (opção -d), se houver.
+    const char *caminhoDoDiario = NULL;
+    if (argc >= 3 && !strcmp(argv[argc - 2], "-d"))
+    {
+        caminhoDoDiario = argv[argc - 1];
+        argc -= 2;
+        // O diário só vale para o modo interativo, aberto sem outros
+        // argumentos ou com o comando -t.
+        if (argc != 1 && !(argc == 4 && !strcmp(argv[1], "-t")))
+        {
+            printf("Uso: plataforma [-t horas minutos] -d arquivo\n");
+            return 1;
+        }
+    }
+    /* --------------------------------------------------------------
+    ----------------- ARGUMENTOS ------------------------------------
+    -------------------------------------------------------------- */
+    // Se o programa for aberto com nenhum argumento, entra no modo
+    // interativo com o horário padrão (12:00).
+    if (argc == 1)
+    {
+        // Modo interativo padrão.
+    }
+    // Modo custo: calcula o gasto de energia em situações ideais, por
+    // 30 dias (um mês) ou pelo número de dias especificado, com o custo
+    // de cada dia e de cada mês do calendário.
+    else if ((argc == 2 || argc == 3) && !strcmp(argv[1], "custo"))
+    {
+        if (argc == 3 && (!strNumerica(argv[2]) || strlen(argv[2]) > 6
+                          || atoi(argv[2]) < 1))
+        {
+            printf("Uso: plataforma custo [dias]\n");
+            return 1;
+        }
+        int dias = argc == 3 ? atoi(argv[2]) : 30;
+        relogio = 0;
+        int64_t passos = (int64_t)dias * SEGUNDOS_NO_DIA;
+        int meses = mesDoRelogio(passos - 1) + 1;
+        // Cria uma plataforma padrão, com 25 séries de bombas e
+        // 10 guindastes.
+        Bombas *bombas = CriarBombas(NUM_BOMBAS);
+        Guindastes *guindastes = CriarGuindastes(NUM_GUINDASTES);
+        // O resultado completo (custo total, custos de cada dia e de
+        // cada mês e sua divisão entre os consumidores) fica em um só
+        // bloco, que pode ser guardado no cache.
+        size_t tamanhoDoResultado = (1 + dias + meses) * sizeof(double)
+                                    + sizeof(Atribuicao);
+        double *resultado = calloc(1, tamanhoDoResultado);
+        if (bombas == NULL || guindastes == NULL || resultado == NULL)
+        {
+            // Remove as bombas, os guindastes e os custos da memória.
+            removerBombeamento(bombas);
+            removerGuindastes(guindastes);
+            free(resultado);
+            return 2;
+        }
+        double *custosDiarios = resultado + 1;
+        double *custosMensais = custosDiarios + dias;
+        Atribuicao *atribuicao = (Atribuicao *)(custosMensais + meses);
+        // Cria um navio com capacidade extrema, simulando uma
+        // situação em que a troca de navios é instantânea.
+        atualizarNavio(guindastes, INT_MAX);
+        // Um resultado guardado no cache (variável de ambiente
+        // PLATAFORMA_CACHE) para o mesmo número de dias é usado sem
+        // refazer a simulação.
+        Cache *cache = cacheDoAmbiente();
+        int64_t argumentos[] = {dias};
+        uint64_t chave = chaveDoCenario("custo", bombas, guindastes,
+                                        relogio, argumentos, 1);
+        if (!consultarCache(cache, chave, resultado, tamanhoDoResultado))
+        {
+            // Dá os passos de todos os dias, registrando o custo de cada
+            // dia e de cada mês, e sua divisão entre os consumidores.
+            zerarAtribuicao(atribuicao);
+            resultado[0] = passosComResumo(passos, bombas, guindastes,
+                                           &relogio, custosDiarios,
+                                           custosMensais, atribuicao);
+            guardarNoCache(cache, chave, resultado, tamanhoDoResultado);
+        }
+        double custo = resultado[0];
+        // Mostra os custos calculados no terminal.
+        printf("Condições ideais (operação contínua):\n");
+        printf("Custo diário: R$ %.3lf\n", custo / dias);
+        if (dias == 30)
+        {
+            printf("Custo mensal: R$ %.3lf\n", custo);
+        }
+        else
+        {
+            printf("Custo total (%d dias): R$ %.3lf\n", dias, custo);
+        }
+        mostrarResumo(custosDiarios, dias, custosMensais, meses);
+        mostrarAtribuicao(atribuicao, true);
+        // Remove as bombas, os guindastes e os custos da memória.
+        removerBombeamento(bombas);
+        removerGuindastes(guindastes);
+        free(resultado);
+        return 0;
+    }
+    // Modo sensibilidade: funciona como o modo custo, mas calcula
+    // também, na mesma simulação, a derivada do custo em relação a
+    // cada parâmetro contínuo do desafio.
+    else if ((argc == 2 || argc == 3) && !strcmp(argv[1], "sensibilidade"))
+    {
+        if (argc == 3 && (!strNumerica(argv[2]) || strlen(argv[2]) > 6
+                          || atoi(argv[2]) < 1))
+        {
+            printf("Uso: plataforma sensibilidade [dias]\n");
+            return 1;
+        }
+        int dias = argc == 3 ? atoi(argv[2]) : 30;
+        relogio = 0;
+        Bombas *bombas = CriarBombas(NUM_BOMBAS);
+        Guindastes *guindastes = CriarGuindastes(NUM_GUINDASTES);
+        if (bombas == NULL || guindastes == NULL)
+        {
+            removerBombeamento(bombas);
+            removerGuindastes(guindastes);
+            return 2;
+        }
+        atualizarNavio(guindastes, INT_MAX);
+        Dual custo = passosComSensibilidade((int64_t)dias * SEGUNDOS_NO_DIA,
+                                            bombas, guindastes, &relogio);
+        printf("Custo total (%d dias): R$ %.3lf\n", dias, custo.valor);
+        printf("Sensibilidade do custo aos parâmetros:\n");
+        for (int i = 0; i < NUM_PARAMETROS; i++)
+        {
+            // A elasticidade é a variação percentual do custo causada
+            // por uma variação de 1 % no parâmetro.
+            double elasticidade = custo.valor > 0
+                                  ? custo.derivadas[i] * parametros[i].valor
+                                    / custo.valor
+                                  : 0;
+            printf("  %-15s %10.3lf %-7s dCusto = R$ %14.3lf por "
+                   "unidade, elasticidade %+.4lf\n", parametros[i].nome,
+                   parametros[i].valor, parametros[i].unidade,
+                   custo.derivadas[i], elasticidade);
+        }
+        removerBombeamento(bombas);
+        removerGuindastes(guindastes);
+        return 0;
+    }
+    // Modo previsão: prevê a demanda da plataforma à termelétrica nas
+    // próximas horas, a partir do estado inicial do modo interativo,
+    // com navios planejados chegando nos minutos especificados.
+    else if (argc >= 5 && !strcmp(argv[1], "previsao"))
+    {
+        bool binaria = !strcmp(argv[2], "bin");
+        bool valido = (binaria || !strcmp(argv[2], "csv"))
+                      && argc - 5 <= MAX_CHEGADAS;
+        for (int i = 3; i < argc && valido; i++)
+        {
+            valido = strNumerica(argv[i]) && strlen(argv[i]) < 7;
+        }
+        int horas = valido ? atoi(argv[3]) : 0;
+        int resolucao = valido ? atoi(argv[4]) : 0;
+        int numChegadas = argc - 5;
+        ChegadaDeNavio chegadas[MAX_CHEGADAS];
+        for (int i = 0; i < numChegadas && valido; i++)
+        {
+            chegadas[i].segundos = atol(argv[5 + i]) * 60;
+            chegadas[i].capacidade = CAPACIDADE_DO_NAVIO;
+            // Os navios devem estar em ordem de chegada.
+            valido = i == 0
+                     || chegadas[i].segundos >= chegadas[i - 1].segundos;
+        }
+        if (!valido || horas < 1 || horas > 24 * 366 || resolucao < 1
+            || resolucao > 60 * 60 * 24)
+        {
+            printf("Uso: plataforma previsao csv|bin horas resolucao "
+                   "[chegadas]\n");
+            return 1;
+        }
+        Previsao *previsao = CriarPrevisao(horas, resolucao, NUM_BOMBAS,
+                                           NUM_GUINDASTES);
+        Arena *arena = CriarArena(tamanhoDasPlataformas(1, NUM_BOMBAS,
+                                                        NUM_GUINDASTES));
+        if (previsao == NULL || arena == NULL)
+        {
+            removerPrevisao(previsao);
+            removerArena(arena);
+            return 2;
+        }
+        // O mesmo estado inicial do modo interativo: 12:00, com um
+        // navio de capacidade padrão atracado.
+        Plataforma *plataforma = CriarPlataformasNaArena(arena, 1, NUM_BOMBAS,
+                                                         NUM_GUINDASTES);
+        plataforma->relogio = relogio;
+        atualizarNavio(plataforma->guindastes, CAPACIDADE_DO_NAVIO);
+        preverDemanda(previsao, plataforma, chegadas, numChegadas);
+        bool escrito = true;
+        if (binaria)
+        {
+            escrito = escreverPrevisaoBinaria(previsao, stdout);
+        }
+        else
+        {
+            escreverPrevisaoCSV(previsao, stdout);
+        }
+        removerPrevisao(previsao);
+        removerArena(arena);
+        return escrito ? 0 : 2;
+    }
+    // Modo rede: simula várias plataformas alimentadas pela mesma
+    // termelétrica, por um número de dias.
+    else if (argc >= 4 && argc <= 6 && !strcmp(argv[1], "rede"))
+    {
+        const PoliticaDeCorte *politica = NULL;
+        if (argc == 6)
+        {
+            politica = acharPoliticaDeCorte(argv[5]);
+        }
+        if (!strNumerica(argv[2]) || !strNumerica(argv[3])
+            || atoi(argv[2]) < 1 || strlen(argv[3]) > 6
+            || atoi(argv[3]) < 1
+            || (argc >= 5 && strcmp(argv[4], "justa")
+                && strcmp(argv[4], "prioridade"))
+            || (argc == 6 && politica == NULL))
+        {
+            printf("Uso: plataforma rede plataformas dias "
+                   "[justa|prioridade] [politica]\n");
+            return 1;
+        }
+        int quantidade = atoi(argv[2]);
+        int dias = atoi(argv[3]);
+        CriterioDeDivisao criterio = DIVISAO_JUSTA;
+        if (argc >= 5 && !strcmp(argv[4], "prioridade"))
+        {
+            criterio = DIVISAO_POR_PRIORIDADE;
+        }
+        // Cria todas as plataformas da rede em uma única arena.
+        Arena *arena = CriarArena(tamanhoDaRede(quantidade));
+        if (arena == NULL)
+        {
+            return 2;
+        }
+        Rede *rede = CriarRedeNaArena(arena, quantidade, criterio);
+        rede->politica = politica;
+        double custoTotal = passosDaRede(rede,
+                                         (int64_t)dias * SEGUNDOS_NO_DIA);
+        // Mostra os custos calculados no terminal.
+        for (int i = 0; i < quantidade; i++)
+        {
+            printf("Plataforma %02d: R$ %.3lf (%d bombas, %d guindastes)\n",
+                   i+1, rede->custos[i],
+                   rede->plataformas[i].bombas->ativas,
+                   rede->plataformas[i].guindastes->ativos);
+        }
+        printf("Passos com corte de carga: %ld\n", rede->passosComCorte);
+        printf("Custo total: R$ %.3lf\n", custoTotal);
+        removerArena(arena);
+        return 0;
+    }
+    // Modo políticas: compara as políticas de corte de carga em uma
+    // plataforma com a energia da termelétrica limitada.
+    else if ((argc == 3 || argc == 4) && !strcmp(argv[1], "politicas"))
+    {
+        if (!strNumerica(argv[2])
+            || (argc == 4 && (!strNumerica(argv[3]) || strlen(argv[3]) > 6
+                              || atoi(argv[3]) < 1)))
+        {
+            printf("Uso: plataforma politicas limite_kW [dias]\n");
+            return 1;
+        }
+        double limite = atoi(argv[2]);
+        int dias = argc == 4 ? atoi(argv[3]) : 1;
+        int melhor = 0;
+        double melhorRendimento = -1;
+        printf("Limite da termelétrica: %.0lf kW, %d dia(s)\n", limite,
+               dias);
+        for (int i = 0; i < NUM_POLITICAS_DE_CORTE; i++)
+        {
+            Desempenho desempenho;
+            if (!avaliarPoliticaDeCorte(&politicasDeCorte[i], limite,
+                                        (int64_t)dias * SEGUNDOS_NO_DIA,
+                                        &desempenho))
+            {
+                return 2;
+            }
+            // Barris carregados por kWh fornecido pela termelétrica.
+            double rendimento = desempenho.energia > 0
+                                ? desempenho.barris / desempenho.energia
+                                : 0;
+            printf("%-12s (%s): %ld barris, %.1lf barris/hora, "
+                   "%.3lf kWh, R$ %.3lf, %.4lf barris/kWh\n",
+                   politicasDeCorte[i].nome, politicasDeCorte[i].descricao,
+                   desempenho.barris, desempenho.barris / (24.0 * dias),
+                   desempenho.energia, desempenho.custo, rendimento);
+            if (rendimento > melhorRendimento)
+            {
+                melhorRendimento = rendimento;
+                melhor = i;
+            }
+        }
+        printf("Maior rendimento: %s\n", politicasDeCorte[melhor].nome);
+        return 0;
+    }
+    // Modo paralelo: funciona como o modo custo, por um número de
+    // dias, mas dividindo o horizonte em trechos simulados em
+    // paralelo.
+    else if ((argc == 3 || argc == 4) && !strcmp(argv[1], "paralelo"))
+    {
+        if (!strNumerica(argv[2]) || strlen(argv[2]) > 6
+            || atoi(argv[2]) < 1
+            || (argc == 4 && (!strNumerica(argv[3]) || atoi(argv[3]) < 1)))
+        {
+            printf("Uso: plataforma paralelo dias [trechos]\n");
+            return 1;
+        }
+        int dias = atoi(argv[2]);
+        // Por padrão, cada dia é um trecho.
+        int trechos = argc == 4 ? atoi(argv[3]) : dias;
+        Arena *arena = CriarArena(tamanhoDasPlataformas(1, NUM_BOMBAS,
+                                                        NUM_GUINDASTES));
+        if (arena == NULL)
+        {
+            return 2;
+        }
+        Plataforma *plataforma = CriarPlataformasNaArena(arena, 1, NUM_BOMBAS,
+                                                         NUM_GUINDASTES);
+        atualizarNavio(plataforma->guindastes, INT_MAX);
+        int iteracoes;
+        double custo = passosNEmParalelo((int64_t)dias * SEGUNDOS_NO_DIA,
+                                         trechos, plataforma, &iteracoes);
+        removerArena(arena);
+        if (custo < 0)
+        {
+            return 2;
+        }
+        printf("Condições ideais (operação contínua):\n");
+        printf("Custo diário: R$ %.3lf\n", custo / dias);
+        printf("Custo total: R$ %.3lf\n", custo);
+        printf("Trechos: %d, rodadas de simulação: %d\n", trechos,
+               iteracoes);
+        return 0;
+    }
+    // Modo preparação: compara a operação com trocas de navios com e
+    // sem a preparação de barris pelos guindastes.
+    else if (argc >= 2 && argc <= 4 && !strcmp(argv[1], "preparacao"))
+    {
+        if ((argc >= 3 && (!strNumerica(argv[2]) || strlen(argv[2]) > 6
+                           || atoi(argv[2]) < 1))
+            || (argc == 4 && (!strNumerica(argv[3]) || atoi(argv[3]) < 1)))
+        {
+            printf("Uso: plataforma preparacao [dias] [capacidade]\n");
+            return 1;
+        }
+        int dias = argc >= 3 ? atoi(argv[2]) : 7;
+        int capacidade = argc == 4 ? atoi(argv[3]) : 20000;
+        long barris[2];
+        double custos[2];
+        printf("%d dia(s), navios de %d barris, %d s entre navios:\n",
+               dias, capacidade, TEMPO_DE_TROCA);
+        for (int preparacao = 0; preparacao < 2; preparacao++)
+        {
+            relogio = 0;
+            Bombas *bombas = CriarBombas(NUM_BOMBAS);
+            Guindastes *guindastes = CriarGuindastes(NUM_GUINDASTES);
+            if (bombas == NULL || guindastes == NULL)
+            {
+                removerBombeamento(bombas);
+                removerGuindastes(guindastes);
+                return 2;
+            }
+            alterarPreparacao(guindastes, preparacao);
+            atualizarNavio(guindastes, capacidade);
+            int navios;
+            custos[preparacao] = passosComTrocas((int64_t)dias
+                                                 * SEGUNDOS_NO_DIA,
+                                                 bombas, guindastes,
+                                                 &relogio, capacidade,
+                                                 &navios);
+            // Barris dos navios cheios e do navio atracado.
+            barris[preparacao] = (long)navios * capacidade;
+            if (guindastes->estadoDoNavio > 0)
+            {
+                barris[preparacao] += capacidade
+                                      - guindastes->estadoDoNavio;
+            }
+            printf("%s preparação: %d navios, %ld barris "
+                   "(%.1lf barris/hora), %.3lf kWh, R$ %.3lf\n",
+                   preparacao ? "Com" : "Sem", navios, barris[preparacao],
+                   barris[preparacao] / (24.0 * dias),
+                   custos[preparacao] / C_TERMELETRICA,
+                   custos[preparacao]);
+            removerBombeamento(bombas);
+            removerGuindastes(guindastes);
+        }
+        long ganho = barris[1] - barris[0];
+        double custoExtra = custos[1] - custos[0];
+        printf("Ganho: %ld barris (%+.2lf %%), custo extra: R$ %.3lf "
+               "(%.3lf kWh)\n", ganho, 100.0 * ganho / barris[0],
+               custoExtra, custoExtra / C_TERMELETRICA);
+        if (ganho > 0)
+        {
+            printf("Custo extra por barril adicional: R$ %.4lf\n",
+                   custoExtra / ganho);
+        }
+        return 0;
+    }
+    // Se o programa for aberto com 1 argumento:
+    else if (argc == 2)
+    {
+        // Ajuda: mostra os comandos possíveis no terminal.
+        if (!strcmp(argv[1], "-h") || !strcmp(argv[1], "--help"))
+        {
+            ajudaDoPrograma();
+            return 0;
+        }
+        // Comando não identificado: instruções básicas.
+        else
+        {
+            printf("Use 'plataforma --help' para obter ajuda.\n");
+            return 1;
+        }
+    }
+    // Se o programa for aberto com 3 argumentos:
+    else if (argc == 4)
+    {
+        if (strcmp(argv[1], "-t"))
+        {
+            printf("Use 'plataforma --help' para obter ajuda.\n");
+            return 1;
+        }
+        // Comando -t: permite inserir um horário inicial qualquer
+        // para o modo interativo.
+        // Se alguma das entradas não for um número: instruções de
+        // uso do comando -t.
+        if (!strNumerica(argv[2]) || !strNumerica(argv[3]))
+        {
+            printf("Uso: plataforma -t horas minutos\n");
+            return 1;
+        }
+        // Se ambas as entradas são números: os insere como horário
+        // inicial, limitando os valores de hora e minuto para 0-23
+        // e 0-59, respectivamente.
+        char *p; // Variável não usada, necessária para strtol.
+        int minuto = (int)(strtol(argv[3], &p, 10) % 60);
+        int hora = (int)((strtol(argv[3], &p, 10) / 60
+                   + strtol(argv[2], &p, 10)) % 24);
+        relogio = relogioDoHorario(hora, minuto, 0);
+    }
+    // Outras quantidades de argumentos: instruções básicas.
+    else
+    {
+        printf("Use 'plataforma --help' para obter ajuda.\n");
+        return 1;
+    }
+
+    /* --------------------------------------------------------------
+    -------------- MODO INTERATIVO ----------------------------------
+    -------------------------------------------------------------- */
+
+    // Cria uma plataforma padrão, com 25 séries de bombas, 10
+    // guindastes e um navio com capacidade padrão.
+    Bombas *bombas = CriarBombas(NUM_BOMBAS);
+    Guindastes *guindastes = CriarGuindastes(NUM_GUINDASTES);
+    if (bombas == NULL || guindastes == NULL)
+    {
+        // Remove as bombas e guindastes da memória.
+        removerBombeamento(bombas);
+        removerGuindastes(guindastes);
+        return 2;
+    }
+    atualizarNavio(guindastes, CAPACIDADE_DO_NAVIO);
+    // mostrarFracao: true se o usuário quer ver o uso da termelétrica
+    // a cada passo, false se não.
+    bool mostrarFracao = false;
+    double custoTotal = 0;
+    // Abre o diário, se houver, e recupera a sessão registrada nele.
+    Sessao sessao = {bombas, guindastes, &relogio, &custoTotal,
+                     &mostrarFracao};
+    Diario *diario = NULL;
+    // Passos dados desde o último ponto de recuperação do diário.
+    long passosDesdeOPonto = 0;
+    if (caminhoDoDiario != NULL)
+    {
+        // Se o diário passar do limite de tamanho de arquivo do
+        // sistema, o registro falha, em vez de encerrar o programa.
+#ifdef SIGXFSZ
+        signal(SIGXFSZ, SIG_IGN);
+#endif
+        diario = AbrirDiario(caminhoDoDiario, NUM_BOMBAS, NUM_GUINDASTES);
+        if (diario == NULL)
+        {
+            printf("Não foi possível abrir o diário %s.\n",
+                   caminhoDoDiario);
+            removerBombeamento(bombas);
+            removerGuindastes(guindastes);
+            return 2;
+        }
+        if (recuperarPonto(diario, &sessao))
+        {
+            char comando;
+            int argumento, refeitos = 0;
+            while (proximoComando(diario, &sessao, &comando, &argumento))
+            {
+                custoTotal += refazerComando(comando, argumento, &sessao);
+                refeitos++;
+            }
+            printf("Sessão recuperada do diário (%d comandos refeitos).\n",
+                   refeitos);
+            if (refeitos > 0)
+            {
+                passosDesdeOPonto = PASSOS_ENTRE_PONTOS;
+            }
+        }
+        else
+        {
+            registrarPontoNoDiario(&diario, &sessao);
+        }
+    }
+
+    printf("----- MODO INTERATIVO -----\n");
+    printf("Digite 'h' para obter ajuda\n");
+    printf("---------------------------\n\n");
+    while (true)
+    {
+        // Mostra informações resumidas.
+        Calendario calendario;
+        calendarioDoRelogio(relogio, &calendario);
+        printf("Data: %d de %s do ano %lld\n", calendario.dia,
+               nomeDoMes(calendario.mes), (long long)calendario.ano);
+        printf("Horário: %02d:%02d.%02d\n", calendario.hora,
+               calendario.minuto, calendario.segundo);
+        printf("Bombas ativas: %d de %d\n", bombas->ativas, bombas->totais);
+        printf("Guindastes ativos: %d de %d\n", guindastes->ativos, guindastes->totais);
+        printf("Capacidade do navio: %d barris\n", guindastes->estadoDoNavio);
+        // Solicita e executa um comando.
+        while (true)
+        {
+            // Registra um ponto de recuperação no diário de tempos em
+            // tempos, para limitar o que é refeito na recuperação.
+            if (diario != NULL
+                && (passosDesdeOPonto >= PASSOS_ENTRE_PONTOS
+                    || diario->comandosDesdeOPonto >= COMANDOS_ENTRE_PONTOS))
+            {
+                registrarPontoNoDiario(&diario, &sessao);
+                passosDesdeOPonto = 0;
+            }
+            // Solicita um char do usuário.
+            printf("-> ");
+            char comando;
+            // O fim da entrada encerra o programa, para que comandos
+            // inválidos não sejam repetidos (e registrados) sem fim.
+            if (scanf(" %c", &comando) != 1)
+            {
+                comando = 'q';
+            }
+            // Cria uma variável para o custo e para um int qualquer.
+            double custo;
+            int n;
+            // Divisão do custo do avanço atual entre os consumidores.
+            Atribuicao atribuicao;
+            zerarAtribuicao(&atribuicao);
+            switch (comando)
+            {
+                // Comando 'P': avança a simulação em algum número de
+                // passos (até um dia).
+                case 'P':
+                    n = getNum(0, 24*60*60);
+                    registrarNoDiario(&diario, comando, n);
+                    passosDesdeOPonto += n;
+                    custo = passosN(n, bombas, guindastes, &relogio,
+                                    mostrarFracao,
+                                    &atribuicao);
+                    printf("\nCusto: R$ %.3lf\n", custo);
+                    mostrarAtribuicao(&atribuicao, false);
+                    custoTotal += custo;
+                    break;
+                // Comando 'p': avança a simulação um passo.
+                case 'p':
+                    registrarNoDiario(&diario, comando, 0);
+                    passosDesdeOPonto++;
+                    custo = passosN(1, bombas, guindastes, &relogio,
+                                    mostrarFracao,
+                                    &atribuicao);
+                    printf("\nCusto: R$ %.3lf\n", custo);
+                    mostrarAtribuicao(&atribuicao, false);
+                    custoTotal += custo;
+                    break;
+                // Comando 'E': desativa o modo de emergência das
+                // bombas.
+                case 'E':
+                    registrarNoDiario(&diario, comando, 0);
+                    normalizacaoDoBombeamento(bombas);
+                    break;
+                // Comando 'e': ativa o modo de emergência das bombas.
+                case 'e':
+                    registrarNoDiario(&diario, comando, 0);
+                    emergenciaDoBombeamento(bombas);
+                    break;
+                // Comando 'G': altera o número máximo de guindastes
+                // ativos.
+                case 'G':
+                    n = getNum(0, guindastes->totais);
+                    registrarNoDiario(&diario, comando, n);
+                    guindastes->ativosMax = n;
+                    continue;
+                // Comando 'g': mostra o estado dos guindastes.
+                case 'g':
+                    estadoDosGuindastes(guindastes);
+                    continue;
+                // Comando 'B': altera o número de bombas ativas.
+                case 'B':
+                    n = getNum(0, bombas->totais);
+                    registrarNoDiario(&diario, comando, n);
+                    alterarBombasAtivas(bombas, n);
+                    continue;
+                // Comando 'b': mostra o estado das bombas.
+                case 'b':
+                    estadoDoBombeamento(bombas);
+                    continue;
+                // Comando 'N': avança a simulação até o navio
+                // atual estar cheio.
+                case 'N':
+                    registrarNoDiario(&diario, comando, 0);
+                    // O navio pode levar muitos passos para encher,
+                    // então um ponto de recuperação é registrado logo
+                    // depois.
+                    passosDesdeOPonto = PASSOS_ENTRE_PONTOS;
+                    custo = passosNavio(bombas, guindastes, &relogio,
+                                        mostrarFracao,
+                                        &atribuicao);
+                    printf("\nCusto: R$ %.3lf\n", custo);
+                    mostrarAtribuicao(&atribuicao, false);
+                    custoTotal += custo;
+                    break;
+                // Comando 'n': significa a chegada de um navio.
+                case 'n':
+                    registrarNoDiario(&diario, comando, 0);
+                    // Se não há um navio já atracado, continua.
+                    if(atualizarNavio(guindastes, CAPACIDADE_DO_NAVIO))
+                    {
+                        printf("Navio atracado.\n");
+                        printf("Capacidade do navio: %d barris\n",
+                               guindastes->estadoDoNavio);
+                        continue;
+                    }
+                    // Se há, pede um comando novo.
+                    else
+                    {
+                        printf("Já há um navio atracado.\n");
+                        continue;
+                    }
+                // Comando 'v': estima quando o navio atracado ficará
+                // cheio, e o custo até lá, sem avançar a simulação.
+                case 'v':
+                {
+                    Plataforma plataforma = {bombas, guindastes, relogio};
+                    EstimativaDoNavio estimativa;
+                    if (guindastes->estadoDoNavio == 0)
+                    {
+                        printf("Não há um navio atracado.\n");
+                    }
+                    else if (estimarNavioComCache(&plataforma,
+                                                  &estimativa))
+                    {
+                        Calendario cheio;
+                        calendarioDoRelogio(estimativa.relogio, &cheio);
+                        printf("Navio cheio em %lld s, às %02d:%02d.%02d "
+                               "de %d de %s\n",
+                               (long long)estimativa.segundos, cheio.hora,
+                               cheio.minuto, cheio.segundo, cheio.dia,
+                               nomeDoMes(cheio.mes));
+                        printf("Custo estimado: R$ %.3lf\n",
+                               estimativa.custo);
+                    }
+                    else
+                    {
+                        printf("O navio não ficará cheio.\n");
+                    }
+                    continue;
+                }
+                // Comando 'f': prevê a demanda da plataforma à
+                // termelétrica nas próximas horas, sem avançar a
+                // simulação, e a grava em ARQUIVO_DA_PREVISAO.
+                case 'f':
+                {
+                    printf("Horas da previsão:\n");
+                    int horas = getNum(1, 24 * 7);
+                    printf("Duração de cada intervalo, em segundos:\n");
+                    int resolucao = getNum(1, 60 * 60);
+                    printf("Número de navios planejados:\n");
+                    int numChegadas = getNum(0, MAX_CHEGADAS);
+                    ChegadaDeNavio chegadas[MAX_CHEGADAS];
+                    for (int i = 0; i < numChegadas; i++)
+                    {
+                        printf("Chegada do navio %d, em minutos a partir "
+                               "de agora:\n", i + 1);
+                        int minimo = i == 0 ? 0
+                                     : chegadas[i - 1].segundos / 60;
+                        chegadas[i].segundos = getNum(minimo, horas * 60)
+                                               * 60L;
+                        chegadas[i].capacidade = CAPACIDADE_DO_NAVIO;
+                    }
+                    Previsao *previsao = CriarPrevisao(horas, resolucao,
+                                                       bombas->totais,
+                                                       guindastes->totais);
+                    FILE *arquivo = fopen(ARQUIVO_DA_PREVISAO, "w");
+                    if (previsao == NULL || arquivo == NULL)
+                    {
+                        printf("Não foi possível gravar a previsão em "
+                               "%s.\n", ARQUIVO_DA_PREVISAO);
+                    }
+                    else
+                    {
+                        Plataforma plataforma = {bombas, guindastes,
+                                                 relogio};
+                        custo = preverDemanda(previsao, &plataforma,
+                                              chegadas, numChegadas);
+                        escreverPrevisaoCSV(previsao, arquivo);
+                        printf("Previsão gravada em %s (%d intervalos).\n",
+                               ARQUIVO_DA_PREVISAO, previsao->intervalos);
+                        printf("Demanda média máxima: %.3lf kW (%.2lf %% "
+                               "da termelétrica)\n", previsao->pico,
+                               100 * previsao->pico / P_TERMELETRICA);
+                        printf("Custo previsto: R$ %.3lf\n", custo);
+                    }
+                    if (arquivo != NULL)
+                    {
+                        fclose(arquivo);
+                    }
+                    removerPrevisao(previsao);
+                    continue;
+                }
+                // Comando 'T/t': decide se a demanda da termelétrica
+                // será mostrada na tela durante o modo interativo.
+                case 'T':
+                case 't':
+                    registrarNoDiario(&diario, comando, 0);
+                    mostrarFracao = !mostrarFracao;
+                    if (mostrarFracao)
+                    {
+                        printf("Demanda da termelétrica será mostrada.\n");
+                    }
+                    else
+                    {
+                        printf("Demanda da termelétrica não será mostrada.\n");
+                    }
+                    continue;
+                // Comando 'H/h': mostra ajuda do modo interativo.
+                case 'H':
+                case 'h':
+                    ajudoDoModoInterativo();
+                    continue;
+                // Comando 'Q/q': sai do programa.
+                case 'Q':
+                case 'q':
+                    // Fecha o diário com um ponto de recuperação, para
+                    // que a próxima sessão não precise refazer nada.
+                    registrarPontoNoDiario(&diario, &sessao);
+                    removerDiario(diario);
+                    // Remove as bombas e guindastes da memória.
+                    removerBombeamento(bombas);
+                    removerGuindastes(guindastes);
+                    return 0;
+                // Se o comando não é reconhecido, pede um novo.
+                default:
+                    printf("Comando inválido.\n");
+                    continue;
+            }
+            break;
+        }
+        printf("Custo total: R$ %.3lf\n\n", custoTotal);
+    }
+
+    // Remove as bombas e guindastes da memória.
+    removerBombeamento(bombas);
+    removerGuindastes(guindastes);
+    return 0;
+}
+
+/* Refaz um comando do modo interativo registrado no diário, sem
+mostrar nada no terminal. Retorna o custo do comando. */
+double refazerComando(char comando, int argumento, Sessao *sessao)
+{
+    Bombas *bombas = sessao->bombas;
+    Guindastes *guindastes = sessao->guindastes;
+    switch (comando)
+    {
+        case 'P':
+        case 'p':
+            return passosN(comando == 'P' ? argumento : 1, bombas,
+                           guindastes, sessao->relogio, false, NULL);
+        case 'N':
+            return passosNavio(bombas, guindastes, sessao->relogio, false,
+                               NULL);
+        case 'E':
+            normalizacaoDoBombeamento(bombas);
+            break;
+        case 'e':
+            emergenciaDoBombeamento(bombas);
+            break;
+        case 'G':
+            guindastes->ativosMax = argumento;
+            break;
+        case 'B':
+            alterarBombasAtivas(bombas, argumento);
+            break;
+        case 'n':
+            atualizarNavio(guindastes, CAPACIDADE_DO_NAVIO);
+            break;
+        case 'T':
+        case 't':
+            *sessao->mostrarFracao = !*sessao->mostrarFracao;
+            break;
+    }
+    return 0;
+}
+
+/* Mostra o custo de cada mês do calendário, e os dias de menor e de
+maior custo, de uma simulação que começa no início do relógio. */
+void mostrarResumo(const double *custosDiarios, int dias,
+                   const double *custosMensais, int meses)
+{
+    // Dias simulados de cada mês; o último pode estar incompleto.
+    int diasNoMes[meses];
+    for (int m = 0; m < meses; m++)
+    {
+        diasNoMes[m] = 0;
+    }
+    int maisBarato = 0, maisCaro = 0;
+    for (int d = 0; d < dias; d++)
+    {
+        diasNoMes[mesDoRelogio((Relogio)d * SEGUNDOS_NO_DIA)]++;
+        if (custosDiarios[d] < custosDiarios[maisBarato])
+        {
+            maisBarato = d;
+        }
+        if (custosDiarios[d] > custosDiarios[maisCaro])
+        {
+            maisCaro = d;
+        }
+    }
+    printf("Custo por mês:\n");
+    for (int m = 0; m < meses; m++)
+    {
+        printf("  %s do ano %d (%d dias): R$ %.3lf\n",
+               nomeDoMes(m % MESES_NO_ANO + 1), m / MESES_NO_ANO + 1,
+               diasNoMes[m], custosMensais[m]);
+    }
+    Calendario calendario;
+    calendarioDoRelogio((Relogio)maisBarato * SEGUNDOS_NO_DIA, &calendario);
+    printf("Dia de menor custo: %d de %s do ano %lld, R$ %.3lf\n",
+           calendario.dia, nomeDoMes(calendario.mes),
+           (long long)calendario.ano, custosDiarios[maisBarato]);
+    calendarioDoRelogio((Relogio)maisCaro * SEGUNDOS_NO_DIA, &calendario);
+    printf("Dia de maior custo: %d de %s do ano %lld, R$ %.3lf\n",
+           calendario.dia, nomeDoMes(calendario.mes),
+           (long long)calendario.ano, custosDiarios[maisCaro]);
+}
+
+/* Solicita um número do usuário dentro de um limite. */
+int getNum(int minimo, int maximo)
+{
+    int numero;
+    printf("Entre um número entre %d e %d:\n", minimo, maximo);
+    do
+    {
+        printf("-> ");
+        scanf("%d", &numero);
+    }
+    while (numero < minimo || numero > maximo);
+    return numero;
+}
+
+/* Retorna true se str for uma string numérica, false se não. */
+bool strNumerica(char *str)
+{
+    for (int i = 0; str[i] != '\0'; i++)
+    {
+        if (!isdigit(str[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Mostra as instruções de uso do programa e do modo interativo,
+respectivamente. */
+void ajudaDoPrograma(void)
+{
+    printf("Uso:\n");
+    // Modo de uso: interativo.
+    printf("\tplataforma [opções]\n");
+    printf("\tAbre o programa no modo interativo.\n\n");
+    // Modo de uso: custo.
+    printf("\tplataforma custo [dias]\n");
+    printf("\tAbre o programa no modo custo, que simula 30 dias (ou o ");
+    printf("número de dias especificado) e mostra o custo de cada ");
+    printf("mês. Se a variável de ambiente PLATAFORMA_CACHE indicar um ");
+    printf("arquivo, os resultados são guardados nele e reaproveitados ");
+    printf("enquanto o código e as constantes não mudarem.\n\n");
+    // Modo de uso: sensibilidade.
+    printf("\tplataforma sensibilidade [dias]\n");
+    printf("\tFunciona como o modo custo, mas mostra também a derivada ");
+    printf("do custo em relação a cada parâmetro contínuo do desafio, ");
+    printf("calculada na mesma simulação.\n\n");
+    // Modo de uso: paralelo.
+    printf("\tplataforma paralelo dias [trechos]\n");
+    printf("\tFunciona como o modo custo, por um número de dias, ");
+    printf("simulando trechos do horizonte em paralelo.\n\n");
+    // Modo de uso: preparacao.
+    printf("\tplataforma preparacao [dias] [capacidade]\n");
+    printf("\tCompara a operação com trocas de navios com e sem a ");
+    printf("preparação de barris pelos guindastes.\n\n");
+    // Modo de uso: previsao.
+    printf("\tplataforma previsao csv|bin horas resolucao [chegadas]\n");
+    printf("\tPrevê a demanda da termelétrica nas próximas horas, em ");
+    printf("intervalos de resolucao segundos, a partir do estado ");
+    printf("inicial do modo interativo, com navios planejados chegando ");
+    printf("nos minutos especificados.\n\n");
+    // Modo de uso: rede.
+    printf("\tplataforma rede plataformas dias [justa|prioridade] ");
+    printf("[politica]\n");
+    printf("\tSimula várias plataformas alimentadas pela mesma ");
+    printf("termelétrica.\n\n");
+    // Modo de uso: politicas.
+    printf("\tplataforma politicas limite_kW [dias]\n");
+    printf("\tCompara as políticas de corte de carga (padrao, ");
+    printf("rotacao e proporcional) com a energia da termelétrica ");
+    printf("limitada.\n\n");
+    // Opções.
+    printf("\tOpções:\n");
+    printf("\t\t-h --help\n\t\t\tExibe este menu de ajuda\n");
+    printf("\t\t-t [hora] [minuto]\n\t\t\tAltera o horário inicial ");
+    printf("do modo interativo.\n");
+    printf("\t\t-d [arquivo]\n\t\t\tRegistra a sessão do modo ");
+    printf("interativo no diário especificado, recuperando-a se o ");
+    printf("diário já existir.\n");
+}
+void ajudoDoModoInterativo(void)
+{
+    printf("Os comandos que AVANÇAM a simulação mostram o custo do avanço");
+    printf(" atual, o custo total desde o início do programa, e um resumo");
+    printf(" do estado da simulação.\n");
+    printf("COMANDOS:\n");
+    printf("b : exibe o estado de todo o sistema de bombeamento.\n");
+    printf("B : permite alterar o número de bombas ativas.\n");
+    printf("e : ativa o estado de emergência das bombas.\n");
+    printf("E : desativa o esta do emergência das bombas.\n");
+    printf("f : prevê a demanda da termelétrica nas próximas horas, e a grava em %s.\n",
+           ARQUIVO_DA_PREVISAO);
+    printf("g : exibe o estado de todo o sistema de guindastes.\n");
+    printf("G : permite alterar o número máximo de guindastes ativos.\n");
+    printf("h : exibe este menu de ajuda.\n");
+    printf("H : exibe este menu de ajuda.\n");
+    printf("n : tenta atracar um navio.\n");
+    printf("N : AVANÇA a simulação até o navio atracado estiver cheio.\n");
+    printf("p : AVANÇA a simulação um passo.\n");
+    printf("P : AVANÇA a simulação um número arbitrário de passos.\n");
+    printf("q : fecha o programa.\n");
+    printf("Q : fecha o programa.\n");
+    printf("t : decide se a demanda da termelétrica em cada horário será mostrada.\n");
+    printf("T : decide se a demanda da termelétrica em cada horário será mostrada.\n");
+    printf("v : estima quando o navio atracado ficará cheio, e o custo até lá.\n");
+}
+
+/* Registra um comando no diário da sessão. Se o registro falhar, avisa
+o usuário e fecha o diário, que passa a ser nulo. */
+void registrarNoDiario(Diario **diario, char comando, int argumento)
+{
+    if (!registrarComando(*diario, comando, argumento))
+    {
+        printf("Não foi possível registrar o comando no diário; a sessão "
+               "continua sem diário.\n");
+        removerDiario(*diario);
+        *diario = NULL;
+    }
+}
+
+/* Registra um ponto de recuperação no diário da sessão. Se o registro
+falhar, avisa o usuário e fecha o diário, que passa a ser nulo. */
+void registrarPontoNoDiario(Diario **diario, const Sessao *sessao)
+{
+    if (!registrarPonto(*diario, sessao))
+    {
+        printf("Não foi possível registrar o ponto de recuperação no "
+               "diário; a sessão continua sem diário.\n");
+        removerDiario(*diario);
+        *diario = NULL;
+    }
+}
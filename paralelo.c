@@ -0,0 +1,274 @@
+/** Simula longos horizontes em paralelo no tempo. O horizonte é
+ *  dividido em trechos (por exemplo, um por dia), e cada trecho é
+ *  simulado em seu próprio núcleo a partir de um estado inicial
+ *  previsto: o estado inicial da plataforma, com o relógio adiantado.
+ *  Depois de cada rodada, o estado final de cada trecho é comparado
+ *  com o estado inicial previsto do trecho seguinte. Os trechos com
+ *  previsões erradas recebem o estado correto e são simulados de novo,
+ *  até que todas as fronteiras coincidam.
+ *  Como a simulação só depende da capacidade restante do navio quando
+ *  ela é pequena, um trecho cuja previsão errou apenas essa capacidade
+ *  é corrigido sem ser simulado de novo, desde que o navio tenha
+ *  ficado, nas duas versões, com mais barris livres que o número de
+ *  guindastes durante todo o trecho.
+ *  Para que o custo seja idêntico ao de passosN, cada trecho guarda a
+ *  sequência das frações da termelétrica de cada passo, comprimida em
+ *  repetições, e o custo é somado em série no fim.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "energia.h"
+#include "paralelo.h"
+
+/* Uma fração da termelétrica repetida em passos consecutivos. */
+typedef struct {
+    double fracao;
+    int repeticoes;
+} Sequencia;
+
+/* Um trecho do horizonte simulado. */
+typedef struct {
+    // Estado previsto no início do trecho.
+    Plataforma *inicio;
+    // Estado no fim do trecho, simulado a partir do início.
+    Plataforma *fim;
+    // Número de passos do trecho.
+    int64_t passos;
+    // Frações da termelétrica de cada passo do trecho.
+    Sequencia *sequencias;
+    int quantidade;
+    int capacidade;
+    // true se o trecho deve ser simulado na próxima rodada.
+    bool simular;
+    // true se o estado inicial do trecho é o estado correto.
+    bool inicioExato;
+    // true se o trecho já foi simulado a partir do estado correto.
+    bool correto;
+    // true se faltou memória para guardar as frações.
+    bool falhou;
+} Trecho;
+
+/* Guarda a fração da termelétrica de um passo, juntando-a à última
+sequência se for igual. Função local. */
+static void guardarFracao(Trecho *trecho, double fracao)
+{
+    if (trecho->quantidade > 0
+        && trecho->sequencias[trecho->quantidade - 1].fracao == fracao)
+    {
+        trecho->sequencias[trecho->quantidade - 1].repeticoes++;
+        return;
+    }
+    if (trecho->quantidade == trecho->capacidade)
+    {
+        int capacidade = trecho->capacidade ? 2 * trecho->capacidade : 64;
+        Sequencia *sequencias = realloc(trecho->sequencias,
+                                        capacidade * sizeof(Sequencia));
+        if (sequencias == NULL)
+        {
+            trecho->falhou = true;
+            return;
+        }
+        trecho->sequencias = sequencias;
+        trecho->capacidade = capacidade;
+    }
+    trecho->sequencias[trecho->quantidade].fracao = fracao;
+    trecho->sequencias[trecho->quantidade].repeticoes = 1;
+    trecho->quantidade++;
+}
+
+/* Simula um trecho a partir do seu estado inicial. Função local. */
+static void simularTrecho(Trecho *trecho)
+{
+    Plataforma *p = trecho->fim;
+    copiarPlataforma(p, trecho->inicio);
+    trecho->quantidade = 0;
+    for (int64_t i = 0; i < trecho->passos; i++)
+    {
+        double fracaoDaTermeletrica;
+        passo(p->bombas, p->guindastes, &p->relogio, &fracaoDaTermeletrica,
+              false);
+        guardarFracao(trecho, fracaoDaTermeletrica);
+    }
+}
+
+/* Tenta corrigir um trecho cujo estado inicial previsto difere do
+estado correto apenas na capacidade restante do navio. Retorna true
+se a correção foi possível. Função local. */
+static bool corrigirNavio(Trecho *trecho, const Plataforma *correto)
+{
+    if (!plataformasIguais(trecho->inicio, correto, false))
+    {
+        return false;
+    }
+    long diferenca = (long)correto->guindastes->estadoDoNavio
+                     - trecho->inicio->guindastes->estadoDoNavio;
+    // A capacidade do navio só diminui ao longo do trecho, então a
+    // menor capacidade é a do fim. As duas versões do trecho só são
+    // iguais se nenhuma delas chegou perto de encher o navio.
+    long minimo = trecho->fim->guindastes->estadoDoNavio;
+    int totais = trecho->fim->guindastes->totais;
+    if (minimo <= totais || minimo + diferenca <= totais)
+    {
+        return false;
+    }
+    trecho->inicio->guindastes->estadoDoNavio += diferenca;
+    trecho->fim->guindastes->estadoDoNavio += diferenca;
+    return true;
+}
+
+/* Funciona como passosN, mas divide os passos em trechos simulados em
+paralelo, um por núcleo. */
+double passosNEmParalelo(int64_t passos, int trechos,
+                         Plataforma *plataforma, int *iteracoes)
+{
+    *iteracoes = 0;
+    if (trechos < 1)
+    {
+        trechos = 1;
+    }
+    if (trechos > passos)
+    {
+        trechos = passos > 0 ? (int)passos : 1;
+    }
+    int totalDeBombas = plataforma->bombas->totais;
+    int totalDeGuindastes = plataforma->guindastes->totais;
+    // Todos os estados iniciais e finais, e mais um estado usado nas
+    // previsões, ficam em uma única arena.
+    Arena *arena = CriarArena(tamanhoDasPlataformas(2 * trechos + 1,
+                                                    totalDeBombas,
+                                                    totalDeGuindastes));
+    Trecho *lista = calloc(trechos, sizeof(Trecho));
+    Plataforma *estados = NULL;
+    if (arena != NULL)
+    {
+        estados = CriarPlataformasNaArena(arena, 2 * trechos + 1,
+                                          totalDeBombas,
+                                          totalDeGuindastes);
+    }
+    if (estados == NULL || lista == NULL)
+    {
+        removerArena(arena);
+        free(lista);
+        return -1.0;
+    }
+    Plataforma *previsao = &estados[2 * trechos];
+    // Prevê o início de cada trecho: o estado atual da plataforma,
+    // com o relógio adiantado até o início do trecho.
+    for (int k = 0; k < trechos; k++)
+    {
+        Trecho *trecho = &lista[k];
+        trecho->inicio = &estados[2 * k];
+        trecho->fim = &estados[2 * k + 1];
+        // Quando possível, os trechos têm um número inteiro de dias,
+        // já que a operação se repete a cada dia e a previsão acerta
+        // o estado dos guindastes no início de cada um.
+        if (passos % SEGUNDOS_NO_DIA == 0
+            && passos / SEGUNDOS_NO_DIA >= trechos)
+        {
+            int64_t dias = passos / SEGUNDOS_NO_DIA;
+            trecho->passos = (dias / trechos + (k < dias % trechos))
+                             * SEGUNDOS_NO_DIA;
+        }
+        else
+        {
+            trecho->passos = passos / trechos + (k < passos % trechos);
+        }
+        trecho->simular = true;
+        if (k == 0)
+        {
+            copiarPlataforma(trecho->inicio, plataforma);
+        }
+        else
+        {
+            copiarPlataforma(trecho->inicio, lista[k-1].inicio);
+            trecho->inicio->relogio += lista[k-1].passos;
+        }
+    }
+    // Simula os trechos com previsões erradas até que todos estejam
+    // corretos. O primeiro trecho sempre começa do estado correto, e
+    // cada trecho simulado a partir do fim de um trecho correto também
+    // fica correto, então cada rodada acerta pelo menos mais um trecho.
+    lista[0].inicioExato = true;
+    int corretos = 0;
+    while (corretos < trechos)
+    {
+        (*iteracoes)++;
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int k = 0; k < trechos; k++)
+        {
+            if (lista[k].simular)
+            {
+                simularTrecho(&lista[k]);
+            }
+        }
+        int ultimoCorreto = -1;
+        for (int k = 0; k < trechos; k++)
+        {
+            Trecho *trecho = &lista[k];
+            if (trecho->simular && trecho->inicioExato)
+            {
+                trecho->correto = true;
+                corretos++;
+            }
+            trecho->simular = false;
+            if (trecho->correto)
+            {
+                ultimoCorreto = k;
+                continue;
+            }
+            Trecho *anterior = &lista[k-1];
+            // Se o trecho anterior está correto, o início deste trecho
+            // pode ser conferido e, se preciso, corrigido.
+            if (anterior->correto)
+            {
+                if (plataformasIguais(anterior->fim, trecho->inicio, true)
+                    || corrigirNavio(trecho, anterior->fim))
+                {
+                    trecho->correto = true;
+                    corretos++;
+                    ultimoCorreto = k;
+                    continue;
+                }
+                copiarPlataforma(trecho->inicio, anterior->fim);
+                trecho->inicioExato = true;
+                trecho->simular = true;
+                continue;
+            }
+            // Se não, prevê de novo o início do trecho, supondo que a
+            // operação se repete a cada dia: o estado no fim do último
+            // trecho correto, com o relógio e o navio deste trecho.
+            copiarPlataforma(previsao, lista[ultimoCorreto].fim);
+            previsao->relogio = trecho->inicio->relogio;
+            previsao->guindastes->estadoDoNavio =
+                trecho->inicio->guindastes->estadoDoNavio;
+            if (!plataformasIguais(previsao, trecho->inicio, true))
+            {
+                copiarPlataforma(trecho->inicio, previsao);
+                trecho->simular = true;
+            }
+        }
+    }
+    // Soma o custo em série, na mesma ordem de passosN.
+    double custo = 0;
+    bool falhou = false;
+    for (int k = 0; k < trechos; k++)
+    {
+        falhou = falhou || lista[k].falhou;
+        for (int i = 0; i < lista[k].quantidade; i++)
+        {
+            Sequencia *sequencia = &lista[k].sequencias[i];
+            for (int j = 0; j < sequencia->repeticoes; j++)
+            {
+                custo += sequencia->fracao * P_TERMELETRICA *
+                         C_TERMELETRICA / 3600;
+            }
+        }
+        free(lista[k].sequencias);
+    }
+    copiarPlataforma(plataforma, lista[trechos - 1].fim);
+    removerArena(arena);
+    free(lista);
+    return falhou ? -1.0 : custo;
+}
@@ -0,0 +1,19 @@
+#ifndef _PARALELO
+#define _PARALELO
+
+#include "plataforma.h"
+
+/** Protótipos das funções públicas. */
+
+/* Funciona como passosN, mas divide os passos em trechos simulados em
+paralelo, um por núcleo. Cada trecho começa de um estado previsto, e
+os trechos cujo estado inicial não coincide com o estado final do
+trecho anterior são simulados de novo, até que todas as fronteiras
+coincidam. O custo retornado e o estado final da plataforma são
+idênticos aos de uma simulação em série. O número de rodadas de
+simulação é colocado em iteracoes. Retorna um valor negativo se não
+houver memória suficiente. */
+double passosNEmParalelo(int64_t passos, int trechos,
+                         Plataforma *plataforma, int *iteracoes);
+
+#endif // _PARALELO
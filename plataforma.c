@@ -0,0 +1,108 @@
+/** Agrupa as bombas, os guindastes e o relógio de uma plataforma, e
+ *  cria lotes de plataformas em arenas. Assim, milhares de plataformas
+ *  podem ser criadas e descartadas entre simulações com uma única
+ *  reserva de memória, reutilizada a cada execução.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "plataforma.h"
+
+/* Retorna o tamanho, em bytes, que um lote de plataformas ocupa em uma
+arena, incluindo suas bombas e guindastes. */
+size_t tamanhoDasPlataformas(int quantidade, int num_bombas,
+                             int num_guindastes)
+{
+    return ALINHAR_NA_ARENA(quantidade * sizeof(Plataforma))
+           + quantidade * (tamanhoDasBombas(num_bombas)
+                           + tamanhoDosGuindastes(num_guindastes));
+}
+
+/* Cria e inicializa um lote de plataformas em uma arena, todas com o
+relógio no início (00:00.00 do primeiro dia). */
+Plataforma *CriarPlataformasNaArena(Arena *arena, int quantidade,
+                                    int num_bombas, int num_guindastes)
+{
+    if (quantidade < 1
+        || tamanhoDasPlataformas(quantidade, num_bombas, num_guindastes)
+           > arena->capacidade - arena->usados)
+    {
+        return NULL;
+    }
+    // Como o espaço total já foi verificado, nenhuma das reservas
+    // seguintes pode falhar por falta de espaço; só um número inválido
+    // de bombas ou de guindastes as faz falhar. Nesse caso, o espaço
+    // já reservado é devolvido à arena.
+    size_t usados = arena->usados;
+    Plataforma *plataformas = reservarNaArena(arena,
+        quantidade * sizeof(Plataforma));
+    for (int i = 0; i < quantidade; i++)
+    {
+        plataformas[i].bombas = CriarBombasNaArena(arena, num_bombas);
+        plataformas[i].guindastes = CriarGuindastesNaArena(arena,
+                                                           num_guindastes);
+        if (plataformas[i].bombas == NULL
+            || plataformas[i].guindastes == NULL)
+        {
+            arena->usados = usados;
+            return NULL;
+        }
+        plataformas[i].relogio = 0;
+    }
+    return plataformas;
+}
+
+/* Copia todo o estado de uma plataforma para outra, com o mesmo
+número de bombas e de guindastes. As listas da plataforma de destino
+não são substituídas, apenas sobrescritas. */
+void copiarPlataforma(Plataforma *destino, const Plataforma *origem)
+{
+    Bombas *bombas = destino->bombas;
+    Guindastes *guindastes = destino->guindastes;
+    // Guarda as listas do destino antes de copiar as estruturas.
+    bool *estadosDasBombas = bombas->estados;
+    int *progressos = guindastes->progressos;
+    bool *estadosDosGuindastes = guindastes->estados;
+    *bombas = *origem->bombas;
+    *guindastes = *origem->guindastes;
+    bombas->estados = estadosDasBombas;
+    guindastes->progressos = progressos;
+    guindastes->estados = estadosDosGuindastes;
+    memcpy(bombas->estados, origem->bombas->estados,
+           bombas->totais * sizeof(bool));
+    memcpy(guindastes->progressos, origem->guindastes->progressos,
+           guindastes->totais * sizeof(int));
+    memcpy(guindastes->estados, origem->guindastes->estados,
+           guindastes->totais * sizeof(bool));
+    destino->relogio = origem->relogio;
+}
+
+/* Retorna true se duas plataformas, com o mesmo número de bombas e de
+guindastes, estão no mesmo estado. Se considerarNavio for false, a
+capacidade restante do navio atracado não é comparada. */
+bool plataformasIguais(const Plataforma *a, const Plataforma *b,
+                       bool considerarNavio)
+{
+    const Bombas *ba = a->bombas, *bb = b->bombas;
+    const Guindastes *ga = a->guindastes, *gb = b->guindastes;
+    return a->relogio == b->relogio
+        && ba->ativas == bb->ativas
+        && ba->luzAmarela == bb->luzAmarela
+        && ba->luzVermelha == bb->luzVermelha
+        && ba->cortadas == bb->cortadas
+        && ba->rotacao == bb->rotacao
+        && ba->passosNoRodizio == bb->passosNoRodizio
+        && !memcmp(ba->estados, bb->estados, ba->totais * sizeof(bool))
+        && ga->ativos == gb->ativos
+        && ga->ativosMax == gb->ativosMax
+        && ga->limiteDeEnergia == gb->limiteDeEnergia
+        && ga->preparacao == gb->preparacao
+        && ga->barrisPreparados == gb->barrisPreparados
+        && ga->carregando == gb->carregando
+        && (!considerarNavio || ga->estadoDoNavio == gb->estadoDoNavio)
+        && !memcmp(ga->progressos, gb->progressos,
+                   ga->totais * sizeof(int))
+        && !memcmp(ga->estados, gb->estados, ga->totais * sizeof(bool));
+}
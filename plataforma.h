@@ -0,0 +1,53 @@
+#ifndef _PLATAFORMA
+#define _PLATAFORMA
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "arena.h"
+#include "bombas.h"
+#include "guindastes.h"
+#include "relogio.h"
+
+/** Representação programática de uma plataforma completa: seu sistema
+de bombeamento, seu grupo de guindastes e o horário da simulação.
+Várias plataformas podem ser criadas juntas em uma mesma arena, para
+estudos com muitas instâncias. */
+typedef struct {
+    // Sistema de bombeamento da plataforma.
+    Bombas *bombas;
+    // Grupo de guindastes da plataforma.
+    Guindastes *guindastes;
+    // Relógio da simulação da plataforma.
+    Relogio relogio;
+} Plataforma;
+
+/** Protótipos das funções públicas. */
+
+/* Retorna o tamanho, em bytes, que um lote de plataformas ocupa em uma
+arena, incluindo suas bombas e guindastes. */
+size_t tamanhoDasPlataformas(int quantidade, int num_bombas,
+                             int num_guindastes);
+
+/* Cria e inicializa um lote de plataformas em uma arena, todas com o
+relógio no início (00:00.00 do primeiro dia). As plataformas ficam
+em um vetor contíguo, e as bombas e os guindastes de cada uma logo em
+seguida. Retorna um apontador nulo, sem ocupar a arena, se não houver
+espaço suficiente nela ou se o número de bombas ou de guindastes for
+inválido. As plataformas são removidas da memória ao reiniciar ou
+remover a arena. */
+Plataforma *CriarPlataformasNaArena(Arena *arena, int quantidade,
+                                    int num_bombas, int num_guindastes);
+
+/* Copia todo o estado de uma plataforma para outra, com o mesmo
+número de bombas e de guindastes. As listas da plataforma de destino
+não são substituídas, apenas sobrescritas. */
+void copiarPlataforma(Plataforma *destino, const Plataforma *origem);
+
+/* Retorna true se duas plataformas, com o mesmo número de bombas e de
+guindastes, estão no mesmo estado. Se considerarNavio for false, a
+capacidade restante do navio atracado não é comparada. */
+bool plataformasIguais(const Plataforma *a, const Plataforma *b,
+                       bool considerarNavio);
+
+#endif // _PLATAFORMA
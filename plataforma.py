@@ -0,0 +1,183 @@
+"""Acesso à simulação das plataformas a partir do Python, através da
+biblioteca libplataforma.so (gerada com 'make libplataforma.so').
+
+Exemplo:
+	from plataforma import Lote
+	lote = Lote(quantidade=100)
+	lote.passos(60 * 60 * 24)
+	print(lote.custos[0], lote.consultar(0).estadoDoNavio)
+"""
+
+import ctypes
+import os
+
+# Números padrão do desafio (bombas.h e guindastes.h).
+NUM_BOMBAS = 25
+NUM_GUINDASTES = 10
+CAPACIDADE_DO_NAVIO = 203349
+# Navio com capacidade extrema, como no modo custo.
+NAVIO_INFINITO = 2 ** 31 - 1
+
+
+class Consulta(ctypes.Structure):
+	"""Resumo do estado de uma plataforma (Consulta, em biblioteca.h)."""
+	_fields_ = [
+		("hora", ctypes.c_int),
+		("minuto", ctypes.c_int),
+		("segundo", ctypes.c_int),
+		("bombasAtivas", ctypes.c_int),
+		("bombasTotais", ctypes.c_int),
+		("guindastesAtivos", ctypes.c_int),
+		("guindastesTotais", ctypes.c_int),
+		("guindastesAtivosMax", ctypes.c_int),
+		("carregando", ctypes.c_int),
+		("estadoDoNavio", ctypes.c_int),
+		("barrisPreparados", ctypes.c_int),
+		("custo", ctypes.c_double),
+		("relogio", ctypes.c_int64),
+	]
+
+
+class EstimativaDoNavio(ctypes.Structure):
+	"""Quando o navio atracado ficará cheio (EstimativaDoNavio, em
+	estimativa.h)."""
+	_fields_ = [
+		("segundos", ctypes.c_int64),
+		("custo", ctypes.c_double),
+		("relogio", ctypes.c_int64),
+	]
+
+
+def carregar(caminho=None):
+	"""Carrega a biblioteca e declara os tipos das funções."""
+	if caminho is None:
+		caminho = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+		                       "libplataforma.so")
+	bib = ctypes.CDLL(caminho)
+	lote = ctypes.c_void_p
+	declaracoes = {
+		"CriarLote": (lote, [ctypes.c_int] * 4),
+		"passosDoLote": (ctypes.c_double, [lote, ctypes.c_int64]),
+		"passosDaPlataforma": (ctypes.c_double, [lote, ctypes.c_int, ctypes.c_int64]),
+		"passosAteNavioCheio": (ctypes.c_double, [lote, ctypes.c_int]),
+		"consultarPlataforma": (ctypes.c_bool, [lote, ctypes.c_int, ctypes.POINTER(Consulta)]),
+		"estimarNavioDoLote": (ctypes.c_bool, [lote, ctypes.c_int, ctypes.POINTER(EstimativaDoNavio)]),
+		"progressosDosGuindastes": (ctypes.POINTER(ctypes.c_int), [lote, ctypes.c_int]),
+		"estadosDosGuindastes": (ctypes.POINTER(ctypes.c_bool), [lote, ctypes.c_int]),
+		"estadosDasBombas": (ctypes.POINTER(ctypes.c_bool), [lote, ctypes.c_int]),
+		"custosDoLote": (ctypes.POINTER(ctypes.c_double), [lote]),
+		"alterarBombasDaPlataforma": (ctypes.c_bool, [lote, ctypes.c_int, ctypes.c_int]),
+		"alterarGuindastesDaPlataforma": (ctypes.c_bool, [lote, ctypes.c_int, ctypes.c_int]),
+		"atracarNavio": (ctypes.c_bool, [lote, ctypes.c_int, ctypes.c_int]),
+		"alterarEmergencia": (ctypes.c_bool, [lote, ctypes.c_int, ctypes.c_bool]),
+		"removerLote": (None, [lote]),
+	}
+	for nome, (retorno, argumentos) in declaracoes.items():
+		funcao = getattr(bib, nome)
+		funcao.restype = retorno
+		funcao.argtypes = argumentos
+	return bib
+
+
+class Lote:
+	"""Lote de plataformas iguais, simuladas pela biblioteca. As listas
+	devolvidas por custos, progressos e estados são vistas diretamente
+	sobre a memória da biblioteca, sem cópia, e refletem cada passo."""
+
+	def __init__(self, quantidade=1, bombas=NUM_BOMBAS,
+	             guindastes=NUM_GUINDASTES, navio=NAVIO_INFINITO,
+	             biblioteca=None):
+		self._bib = biblioteca or carregar()
+		self._lote = self._bib.CriarLote(quantidade, bombas, guindastes,
+		                                 navio)
+		if not self._lote:
+			raise MemoryError("não foi possível criar o lote")
+		self.quantidade = quantidade
+		self.bombas = bombas
+		self.guindastes = guindastes
+		self.custos = (ctypes.c_double * quantidade).from_address(
+			ctypes.addressof(self._bib.custosDoLote(self._lote).contents))
+
+	def passos(self, passos, indice=None):
+		"""Dá passos em todas as plataformas (em paralelo) ou em uma só.
+		Retorna o custo desses passos, em reais."""
+		if indice is None:
+			return self._bib.passosDoLote(self._lote, passos)
+		return self._verificar(self._bib.passosDaPlataforma(self._lote, indice, passos))
+
+	def passos_navio(self, indice=0):
+		"""Avança uma plataforma até o navio atracado ficar cheio."""
+		return self._verificar(self._bib.passosAteNavioCheio(self._lote, indice))
+
+	def consultar(self, indice=0):
+		"""Retorna o resumo do estado de uma plataforma."""
+		consulta = Consulta()
+		if not self._bib.consultarPlataforma(self._lote, indice, ctypes.byref(consulta)):
+			raise IndexError(indice)
+		return consulta
+
+	def estimar_navio(self, indice=0):
+		"""Estima quando o navio atracado ficará cheio, e o custo até lá,
+		sem avançar a simulação. Retorna None se ele não ficar cheio. Usa
+		o cache indicado pela variável de ambiente PLATAFORMA_CACHE."""
+		estimativa = EstimativaDoNavio()
+		if not self._bib.estimarNavioDoLote(self._lote, indice, ctypes.byref(estimativa)):
+			return None
+		return estimativa
+
+	def progressos(self, indice=0):
+		"""Progressos dos guindastes de uma plataforma, sem cópia."""
+		return self._vista(self._bib.progressosDosGuindastes, indice,
+		                   ctypes.c_int, self.guindastes)
+
+	def estados_dos_guindastes(self, indice=0):
+		"""Estados dos guindastes de uma plataforma, sem cópia."""
+		return self._vista(self._bib.estadosDosGuindastes, indice,
+		                   ctypes.c_bool, self.guindastes)
+
+	def estados_das_bombas(self, indice=0):
+		"""Estados das séries de bombas de uma plataforma, sem cópia."""
+		return self._vista(self._bib.estadosDasBombas, indice,
+		                   ctypes.c_bool, self.bombas)
+
+	def alterar_bombas(self, ativas, indice=0):
+		return self._bib.alterarBombasDaPlataforma(self._lote, indice, ativas)
+
+	def alterar_guindastes(self, ativos_max, indice=0):
+		return self._bib.alterarGuindastesDaPlataforma(self._lote, indice, ativos_max)
+
+	def atracar_navio(self, capacidade=CAPACIDADE_DO_NAVIO, indice=0):
+		return self._bib.atracarNavio(self._lote, indice, capacidade)
+
+	def emergencia(self, ativa=True, indice=0):
+		return self._bib.alterarEmergencia(self._lote, indice, ativa)
+
+	def remover(self):
+		"""Remove o lote da memória da biblioteca. As vistas devolvidas
+		antes deixam de ser válidas."""
+		if self._lote:
+			self._bib.removerLote(self._lote)
+			self._lote = None
+
+	def __del__(self):
+		self.remover()
+
+	def _verificar(self, custo):
+		if custo < 0:
+			raise IndexError("plataforma inexistente")
+		return custo
+
+	def _vista(self, funcao, indice, tipo, tamanho):
+		apontador = funcao(self._lote, indice)
+		if not apontador:
+			raise IndexError(indice)
+		return (tipo * tamanho).from_address(ctypes.addressof(apontador.contents))
+
+
+if __name__ == "__main__":
+	# Reproduz o modo custo do programa principal.
+	lote = Lote()
+	custo_mensal = lote.passos(60 * 60 * 24 * 30)
+	print("Condições ideais (operação contínua):")
+	print(f"Custo diário: R$ {custo_mensal / 30:.3f}")
+	print(f"Custo mensal: R$ {custo_mensal:.3f}")
@@ -0,0 +1,185 @@
+/** Prevê a demanda da plataforma à termelétrica nas próximas horas,
+ *  para que a termelétrica possa se preparar. A previsão avança uma
+ *  cópia da plataforma com avancarRapidamente, que salta os ciclos dos
+ *  guindastes e os períodos sem guindastes; por isso pode ser refeita
+ *  a cada minuto, a partir do estado atual, em poucos milissegundos.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "energia.h"
+#include "estimativa.h"
+#include "previsao.h"
+
+/* Cria uma previsão de uma quantidade de horas, em intervalos da
+resolução especificada (em segundos), para plataformas com o número de
+séries de bombas e de guindastes especificado. Retorna um apontador
+nulo se os valores forem inválidos ou se não houver memória
+suficiente. */
+Previsao *CriarPrevisao(int horas, int resolucao, int num_bombas,
+                        int num_guindastes)
+{
+    if (horas < 1 || resolucao < 1 || num_bombas < 1 || num_guindastes < 1)
+    {
+        return NULL;
+    }
+    int64_t duracao = (int64_t)horas * SEGUNDOS_NA_HORA;
+    long intervalos = (duracao + resolucao - 1) / resolucao;
+    Arena *arena = CriarArena(ALINHAR_NA_ARENA(sizeof(Previsao))
+                              + ALINHAR_NA_ARENA(intervalos
+                                                 * sizeof(double))
+                              + tamanhoDasPlataformas(1, num_bombas,
+                                                      num_guindastes));
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+    Previsao *previsao = reservarNaArena(arena, sizeof(Previsao));
+    previsao->demandas = reservarNaArena(arena,
+                                         intervalos * sizeof(double));
+    previsao->copia = CriarPlataformasNaArena(arena, 1, num_bombas,
+                                              num_guindastes);
+    previsao->intervalos = intervalos;
+    previsao->resolucao = resolucao;
+    previsao->duracao = duracao;
+    previsao->inicio = 0;
+    previsao->pico = 0;
+    previsao->custo = 0;
+    previsao->arena = arena;
+    for (long i = 0; i < intervalos; i++)
+    {
+        previsao->demandas[i] = 0;
+    }
+    return previsao;
+}
+
+/* Prevê a demanda da plataforma à termelétrica, sem alterá-la, a partir
+do seu estado atual. Os navios planejados, em ordem de chegada, atracam
+no horário planejado ou, se ainda houver um navio atracado, assim que
+ele ficar cheio. Retorna o custo total previsto. */
+double preverDemanda(Previsao *previsao, const Plataforma *plataforma,
+                     const ChegadaDeNavio *chegadas, int numChegadas)
+{
+    Plataforma *copia = previsao->copia;
+    Guindastes *guindastes = copia->guindastes;
+    copiarPlataforma(copia, plataforma);
+    previsao->inicio = plataforma->relogio;
+    previsao->pico = 0;
+    previsao->custo = 0;
+    // Próximo navio planejado que ainda não atracou.
+    int proxima = 0;
+    // Segundos já previstos.
+    int64_t agora = 0;
+    for (int i = 0; i < previsao->intervalos; i++)
+    {
+        int64_t fim = (i + (int64_t)1) * previsao->resolucao;
+        if (fim > previsao->duracao)
+        {
+            fim = previsao->duracao;
+        }
+        int64_t inicio = agora;
+        double custo = 0;
+        // O intervalo é dividido nas chegadas dos navios planejados.
+        while (agora < fim)
+        {
+            while (proxima < numChegadas
+                   && chegadas[proxima].segundos <= agora
+                   && atualizarNavio(guindastes,
+                                     chegadas[proxima].capacidade))
+            {
+                proxima++;
+            }
+            int64_t alvo = fim;
+            bool pararComNavioCheio = false;
+            if (proxima < numChegadas)
+            {
+                if (guindastes->estadoDoNavio > 0)
+                {
+                    // O próximo navio atraca assim que este ficar cheio.
+                    pararComNavioCheio = true;
+                }
+                else if (chegadas[proxima].segundos < alvo)
+                {
+                    alvo = chegadas[proxima].segundos;
+                }
+            }
+            int64_t passosDados;
+            custo += avancarRapidamente(copia, alvo - agora,
+                                        pararComNavioCheio, &passosDados);
+            agora += passosDados;
+        }
+        // O custo de cada passo é proporcional à potência demandada.
+        previsao->demandas[i] = custo * 3600 / C_TERMELETRICA
+                                / (fim - inicio);
+        if (previsao->demandas[i] > previsao->pico)
+        {
+            previsao->pico = previsao->demandas[i];
+        }
+        previsao->custo += custo;
+    }
+    return previsao->custo;
+}
+
+/* Escreve a previsão em um arquivo de texto, no formato CSV: uma linha
+por intervalo, com a data e o horário de início, a potência média
+demandada da termelétrica, em kW, e a fração da capacidade da
+termelétrica. */
+void escreverPrevisaoCSV(const Previsao *previsao, FILE *arquivo)
+{
+    fprintf(arquivo, "data,horario,demanda_kW,fracao_da_termeletrica\n");
+    for (int i = 0; i < previsao->intervalos; i++)
+    {
+        Calendario calendario;
+        calendarioDoRelogio(previsao->inicio
+                            + (int64_t)i * previsao->resolucao,
+                            &calendario);
+        fprintf(arquivo, "%04lld-%02d-%02d,%02d:%02d:%02d,%.3lf,%.6lf\n",
+                (long long)calendario.ano, calendario.mes, calendario.dia,
+                calendario.hora, calendario.minuto, calendario.segundo,
+                previsao->demandas[i],
+                previsao->demandas[i] / P_TERMELETRICA);
+    }
+}
+
+/* Escreve a previsão em um arquivo binário: um cabeçalho de 32 bytes
+(a assinatura "PLTPREV2", o número de intervalos e a resolução como
+inteiros de 32 bits, e o relógio inicial e um campo reservado como
+inteiros de 64 bits), seguido da potência média de cada intervalo, em
+kW, como float de 32 bits. Retorna false se não for possível
+escrever. */
+bool escreverPrevisaoBinaria(const Previsao *previsao, FILE *arquivo)
+{
+    struct {
+        char assinatura[8];
+        int32_t intervalos;
+        int32_t resolucao;
+        int64_t inicio;
+        int64_t reservado;
+    } cabecalho = {{'P', 'L', 'T', 'P', 'R', 'E', 'V', '2'},
+                   previsao->intervalos, previsao->resolucao,
+                   previsao->inicio, 0};
+    if (fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) != 1)
+    {
+        return false;
+    }
+    for (int i = 0; i < previsao->intervalos; i++)
+    {
+        float demanda = (float)previsao->demandas[i];
+        if (fwrite(&demanda, sizeof(demanda), 1, arquivo) != 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Remove a previsão, e a cópia da plataforma, da memória. */
+void removerPrevisao(Previsao *previsao)
+{
+    if (previsao != NULL)
+    {
+        removerArena(previsao->arena);
+    }
+}
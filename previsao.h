@@ -0,0 +1,83 @@
+#ifndef _PREVISAO
+#define _PREVISAO
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "arena.h"
+#include "plataforma.h"
+
+/* Número máximo de chegadas de navios planejadas em uma previsão. */
+#define MAX_CHEGADAS 32
+
+/** Chegada planejada de um navio à plataforma. */
+typedef struct {
+    // Segundos, a partir do início da previsão, em que o navio chega.
+    int64_t segundos;
+    // Capacidade do navio, em barris.
+    int capacidade;
+} ChegadaDeNavio;
+
+/** Previsão da demanda da plataforma à termelétrica nas próximas
+horas, em intervalos de duração fixa. A previsão é calculada sobre uma
+cópia da plataforma, guardada na mesma arena que os intervalos, para
+que possa ser refeita sem nenhuma reserva de memória. */
+typedef struct {
+    // Número de intervalos da previsão.
+    int intervalos;
+    // Duração de cada intervalo, em segundos. O último intervalo pode
+    // ser mais curto, se a duração total não for múltipla dela.
+    int resolucao;
+    // Duração total da previsão, em segundos.
+    int64_t duracao;
+    // Relógio da plataforma no início da previsão.
+    Relogio inicio;
+    // Potência média, em kW, demandada da termelétrica em cada
+    // intervalo.
+    double *demandas;
+    // Maior potência média entre os intervalos, em kW.
+    double pico;
+    // Custo total da energia prevista, em reais.
+    double custo;
+    // Cópia da plataforma, avançada durante a previsão.
+    Plataforma *copia;
+    // Arena que contém a previsão, os intervalos e a cópia.
+    Arena *arena;
+} Previsao;
+
+/** Protótipos das funções públicas. */
+
+/* Cria uma previsão de uma quantidade de horas, em intervalos da
+resolução especificada (em segundos), para plataformas com o número de
+séries de bombas e de guindastes especificado. Retorna um apontador
+nulo se os valores forem inválidos ou se não houver memória
+suficiente. */
+Previsao *CriarPrevisao(int horas, int resolucao, int num_bombas,
+                        int num_guindastes);
+
+/* Prevê a demanda da plataforma à termelétrica, sem alterá-la, a partir
+do seu estado atual. Os navios planejados, em ordem de chegada, atracam
+no horário planejado ou, se ainda houver um navio atracado, assim que
+ele ficar cheio. Retorna o custo total previsto. */
+double preverDemanda(Previsao *previsao, const Plataforma *plataforma,
+                     const ChegadaDeNavio *chegadas, int numChegadas);
+
+/* Escreve a previsão em um arquivo de texto, no formato CSV: uma linha
+por intervalo, com a data e o horário de início, a potência média
+demandada da termelétrica, em kW, e a fração da capacidade da
+termelétrica. */
+void escreverPrevisaoCSV(const Previsao *previsao, FILE *arquivo);
+
+/* Escreve a previsão em um arquivo binário: um cabeçalho de 32 bytes
+(a assinatura "PLTPREV2", o número de intervalos e a resolução como
+inteiros de 32 bits, e o relógio inicial e um campo reservado como
+inteiros de 64 bits), seguido da potência média de cada intervalo, em
+kW, como float de 32 bits. Retorna false se não for possível
+escrever. */
+bool escreverPrevisaoBinaria(const Previsao *previsao, FILE *arquivo);
+
+/* Remove a previsão, e a cópia da plataforma, da memória. */
+void removerPrevisao(Previsao *previsao);
+
+#endif // _PREVISAO
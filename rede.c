@@ -0,0 +1,337 @@
+/** Simula várias plataformas alimentadas pela mesma termelétrica e
+ *  pelo mesmo parque eólico. As plataformas avançam em paralelo (uma
+ *  por núcleo, através do OpenMP), registrando suas cargas. A demanda
+ *  da termelétrica é calculada para a rede inteira, descontando o
+ *  parque eólico uma única vez, e o custo de cada passo é dividido
+ *  entre as plataformas na proporção de suas cargas.
+ *  Se, durante um trecho, a demanda da rede pode passar da capacidade
+ *  da termelétrica, a cada passo a capacidade é dividida entre as
+ *  plataformas, por prioridade ou igualmente, e cada plataforma desliga
+ *  seus próprios guindastes e bombas até caber na parte que recebeu. Se
+ *  não pode, as plataformas avançam independentemente pelos
+ *  PASSOS_POR_TRECHO passos do trecho, e só se sincronizam ao fim dele.
+ */
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "energia.h"
+#include "rede.h"
+
+/** Demanda de uma plataforma, com o seu índice, ordenada por
+dividirJustamente. */
+typedef struct {
+    double demanda;
+    int indice;
+} DemandaIndexada;
+
+/* Retorna o tamanho, em bytes, que uma rede com a quantidade de
+plataformas padrão especificada ocupa em uma arena. */
+size_t tamanhoDaRede(int quantidade)
+{
+    return ALINHAR_NA_ARENA(sizeof(Rede))
+           + tamanhoDasPlataformas(quantidade, NUM_BOMBAS, NUM_GUINDASTES)
+           + ALINHAR_NA_ARENA((size_t)quantidade * PASSOS_POR_TRECHO
+                              * sizeof(double))
+           + ALINHAR_NA_ARENA(PASSOS_POR_TRECHO * sizeof(double))
+           + 3 * ALINHAR_NA_ARENA(quantidade * sizeof(double));
+}
+
+/* Cria uma rede de plataformas padrão (25 séries de bombas e 10
+guindastes), cada uma com um navio de capacidade extrema, em uma
+arena. Retorna um apontador nulo se não houver espaço na arena. */
+Rede *CriarRedeNaArena(Arena *arena, int quantidade,
+                       CriterioDeDivisao criterio)
+{
+    if (quantidade < 1
+        || tamanhoDaRede(quantidade) > arena->capacidade - arena->usados)
+    {
+        return NULL;
+    }
+    Rede *rede = reservarNaArena(arena, sizeof(Rede));
+    rede->plataformas = CriarPlataformasNaArena(arena, quantidade,
+                                                NUM_BOMBAS,
+                                                NUM_GUINDASTES);
+    rede->cargas = reservarNaArena(arena, (size_t)quantidade
+                                          * PASSOS_POR_TRECHO
+                                          * sizeof(double));
+    rede->fatores = reservarNaArena(arena,
+                                    PASSOS_POR_TRECHO * sizeof(double));
+    rede->demandas = reservarNaArena(arena, quantidade * sizeof(double));
+    rede->cotas = reservarNaArena(arena, quantidade * sizeof(double));
+    rede->custos = reservarNaArena(arena, quantidade * sizeof(double));
+    for (int i = 0; i < quantidade; i++)
+    {
+        atualizarNavio(rede->plataformas[i].guindastes, INT_MAX);
+        rede->custos[i] = 0;
+    }
+    rede->quantidade = quantidade;
+    rede->passosComCorte = 0;
+    rede->criterio = criterio;
+    rede->politica = NULL;
+    return rede;
+}
+
+/* Compara duas demandas indexadas, para ordená-las da menor para a
+maior. Usado por dividirJustamente. Função local. */
+static int compararDemandas(const void *a, const void *b)
+{
+    double da = ((const DemandaIndexada *)a)->demanda;
+    double db = ((const DemandaIndexada *)b)->demanda;
+    return (da > db) - (da < db);
+}
+
+/* Divide a capacidade da termelétrica igualmente entre as
+plataformas. As plataformas que demandam menos que sua parte recebem
+apenas o que demandam, e a sobra é dividida entre as restantes.
+Função local. */
+static void dividirJustamente(Rede *rede, DemandaIndexada *ordem)
+{
+    for (int i = 0; i < rede->quantidade; i++)
+    {
+        ordem[i].demanda = rede->demandas[i];
+        ordem[i].indice = i;
+    }
+    qsort(ordem, rede->quantidade, sizeof(DemandaIndexada),
+          compararDemandas);
+    double restante = P_TERMELETRICA;
+    for (int i = 0; i < rede->quantidade; i++)
+    {
+        int indice = ordem[i].indice;
+        double parte = restante / (rede->quantidade - i);
+        if (rede->demandas[indice] < parte)
+        {
+            parte = rede->demandas[indice];
+        }
+        rede->cotas[indice] = parte;
+        restante -= parte;
+    }
+}
+
+/* Divide a capacidade da termelétrica entre as plataformas, em ordem
+de prioridade. Função local. */
+static void dividirPorPrioridade(Rede *rede)
+{
+    double restante = P_TERMELETRICA;
+    for (int i = 0; i < rede->quantidade; i++)
+    {
+        double parte = rede->demandas[i];
+        if (parte > restante)
+        {
+            parte = restante;
+        }
+        rede->cotas[i] = parte;
+        restante -= parte;
+    }
+}
+
+/* Calcula a demanda da termelétrica em um passo do trecho, a partir
+das cargas das plataformas e da potência do parque eólico, em kW. Se
+ela passar da capacidade da termelétrica, divide a capacidade entre as
+plataformas de acordo com o critério da rede, coloca no endereço de
+memória especificado a potência das turbinas reservada para cada kW de
+carga e retorna true. Função local. */
+static bool dividirCapacidade(Rede *rede, int passo, double turbinas,
+                              DemandaIndexada *ordem,
+                              double *turbinasPorCarga)
+{
+    double cargaTotal = 0;
+    for (int i = 0; i < rede->quantidade; i++)
+    {
+        cargaTotal += rede->cargas[i * PASSOS_POR_TRECHO + passo];
+    }
+    double demandaTotal = (cargaTotal - turbinas) / E_INVERSORES;
+    // Se a termelétrica é capaz de suprir todas as plataformas, não há
+    // o que dividir.
+    if (demandaTotal <= P_TERMELETRICA)
+    {
+        return false;
+    }
+    // A demanda e a energia das turbinas são divididas entre as
+    // plataformas na proporção de suas cargas.
+    for (int i = 0; i < rede->quantidade; i++)
+    {
+        rede->demandas[i] = demandaTotal
+                            * rede->cargas[i * PASSOS_POR_TRECHO + passo]
+                            / cargaTotal;
+    }
+    *turbinasPorCarga = turbinas / cargaTotal;
+    rede->passosComCorte++;
+    if (rede->criterio == DIVISAO_JUSTA)
+    {
+        dividirJustamente(rede, ordem);
+    }
+    else
+    {
+        dividirPorPrioridade(rede);
+    }
+    return true;
+}
+
+/* Retorna true se a demanda da rede puder passar da capacidade da
+termelétrica: se todas as plataformas religassem as bombas cortadas
+temporariamente e ativassem o número máximo de guindastes, no horário
+de menor vento. As bombas desligadas permanentemente pela política
+padrão não são religadas. Função local. */
+static bool podeFaltarEnergia(Rede *rede)
+{
+    double cargaMaxima = 0;
+    for (int i = 0; i < rede->quantidade; i++)
+    {
+        Bombas *bombas = rede->plataformas[i].bombas;
+        Guindastes *guindastes = rede->plataformas[i].guindastes;
+        int guindastesAtivos = guindastes->ativos > guindastes->ativosMax
+                               ? guindastes->ativos : guindastes->ativosMax;
+        cargaMaxima += P_AUXILIAR
+                       + (bombas->ativas + bombas->cortadas) * P_BOMBA
+                       + guindastesAtivos * P_GUINDASTE;
+    }
+    return (cargaMaxima - potenciaDasTurbinas(0)) / E_INVERSORES
+           > P_TERMELETRICA;
+}
+
+/* Dá uma quantidade pré-determinada de passos em todas as plataformas
+da rede, acumulando o custo de cada uma. Retorna o custo total
+acumulado pela rede desde a sua criação. */
+double passosDaRede(Rede *rede, int64_t passos)
+{
+    DemandaIndexada *ordem = malloc(rede->quantidade
+                                    * sizeof(DemandaIndexada));
+    if (ordem == NULL)
+    {
+        return 0.0;
+    }
+    int quantidade = rede->quantidade;
+    const PoliticaDeCorte *politica = rede->politica;
+    Relogio inicio = rede->plataformas[0].relogio;
+    // Decisões do trecho e do último passo dividido, compartilhadas
+    // pelos núcleos.
+    bool sincronizarPassos = false;
+    bool corte = false;
+    double turbinasPorCarga = 0;
+    // Uma única região paralela cobre todos os passos, para que os
+    // núcleos não sejam criados e destruídos a cada trecho.
+    #pragma omp parallel
+    for (int64_t base = 0; base < passos; base += PASSOS_POR_TRECHO)
+    {
+        int trecho = passos - base < PASSOS_POR_TRECHO
+                     ? (int)(passos - base) : PASSOS_POR_TRECHO;
+        // Os passos só precisam ser sincronizados se a capacidade da
+        // termelétrica puder ter de ser dividida durante o trecho.
+        #pragma omp single
+        sincronizarPassos = podeFaltarEnergia(rede);
+        if (!sincronizarPassos)
+        {
+            // A capacidade nunca precisa ser dividida: cada plataforma
+            // dá todos os passos do trecho sem esperar as outras.
+            #pragma omp for schedule(static)
+            for (int i = 0; i < quantidade; i++)
+            {
+                Plataforma *plataforma = &rede->plataformas[i];
+                double *cargas = &rede->cargas[i * PASSOS_POR_TRECHO];
+                for (int k = 0; k < trecho; k++)
+                {
+                    plataforma->relogio++;
+                    int hora = horaDoRelogio(plataforma->relogio);
+                    atualizarGuindastes(plataforma->guindastes, hora);
+                    ajustarDemandaComLimite(plataforma->bombas,
+                                            plataforma->guindastes, hora,
+                                            P_TERMELETRICA, politica);
+                    cargas[k] = cargaDaPlataforma(plataforma->bombas,
+                                                  plataforma->guindastes);
+                }
+            }
+        }
+        else
+        {
+            for (int k = 0; k < trecho; k++)
+            {
+                int hora = horaDoRelogio(inicio + base + k + 1);
+                // Avança cada plataforma e calcula sua carga.
+                #pragma omp for schedule(static)
+                for (int i = 0; i < quantidade; i++)
+                {
+                    Plataforma *plataforma = &rede->plataformas[i];
+                    plataforma->relogio++;
+                    atualizarGuindastes(plataforma->guindastes, hora);
+                    rede->cargas[i * PASSOS_POR_TRECHO + k] =
+                        cargaSemCorte(plataforma->bombas,
+                                      plataforma->guindastes, hora);
+                }
+                // Divide a capacidade da termelétrica em um só núcleo.
+                #pragma omp single
+                corte = dividirCapacidade(rede, k,
+                                          potenciaDasTurbinas(hora), ordem,
+                                          &turbinasPorCarga);
+                // Cada plataforma se ajusta à parte que recebeu. Com a
+                // mesma divisão estática, cada núcleo volta às mesmas
+                // plataformas no passo seguinte, sem precisar esperar
+                // os outros.
+                #pragma omp for schedule(static) nowait
+                for (int i = 0; i < quantidade; i++)
+                {
+                    Plataforma *plataforma = &rede->plataformas[i];
+                    double *carga = &rede->cargas[i * PASSOS_POR_TRECHO
+                                                  + k];
+                    if (corte)
+                    {
+                        ajustarDemandaComTurbinas(plataforma->bombas,
+                                                  plataforma->guindastes,
+                                                  *carga
+                                                  * turbinasPorCarga,
+                                                  rede->cotas[i],
+                                                  politica);
+                    }
+                    else
+                    {
+                        ajustarDemandaComLimite(plataforma->bombas,
+                                                plataforma->guindastes,
+                                                hora, P_TERMELETRICA,
+                                                politica);
+                    }
+                    *carga = cargaDaPlataforma(plataforma->bombas,
+                                               plataforma->guindastes);
+                }
+            }
+            #pragma omp barrier
+        }
+        // Calcula a potência da termelétrica em cada passo do trecho,
+        // para a rede inteira, e o seu custo por kW de carga.
+        #pragma omp for schedule(static)
+        for (int k = 0; k < trecho; k++)
+        {
+            double carga = 0;
+            for (int i = 0; i < quantidade; i++)
+            {
+                carga += rede->cargas[i * PASSOS_POR_TRECHO + k];
+            }
+            double potencia = demandaDaTermeletrica(
+                carga, horaDoRelogio(inicio + base + k + 1));
+            if (potencia > P_TERMELETRICA)
+            {
+                potencia = P_TERMELETRICA;
+            }
+            rede->fatores[k] = potencia * C_TERMELETRICA / 3600 / carga;
+        }
+        // Divide o custo de cada passo na proporção das cargas.
+        #pragma omp for schedule(static)
+        for (int i = 0; i < quantidade; i++)
+        {
+            const double *cargas = &rede->cargas[i * PASSOS_POR_TRECHO];
+            double custo = 0;
+            for (int k = 0; k < trecho; k++)
+            {
+                custo += cargas[k] * rede->fatores[k];
+            }
+            rede->custos[i] += custo;
+        }
+    }
+    free(ordem);
+    double custo = 0;
+    for (int i = 0; i < rede->quantidade; i++)
+    {
+        custo += rede->custos[i];
+    }
+    return custo;
+}
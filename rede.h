@@ -0,0 +1,77 @@
+#ifndef _REDE
+#define _REDE
+
+#include "arena.h"
+#include "corte.h"
+#include "plataforma.h"
+
+/* Critérios de divisão da capacidade da termelétrica entre as
+plataformas de uma rede, quando a demanda total é maior que a
+capacidade. */
+typedef enum {
+    // Plataformas com menor índice são atendidas primeiro.
+    DIVISAO_POR_PRIORIDADE,
+    // A capacidade é dividida igualmente, e a sobra das plataformas
+    // que demandam menos que sua parte é redistribuída às outras.
+    DIVISAO_JUSTA
+} CriterioDeDivisao;
+
+/* Número de passos que as plataformas de uma rede dão entre duas
+sincronizações, quando a demanda da rede nunca passa da capacidade da
+termelétrica. */
+#define PASSOS_POR_TRECHO 600
+
+/** Representação programática de uma rede de plataformas alimentadas
+pela mesma termelétrica e pelo mesmo parque eólico. A demanda da
+termelétrica é calculada uma vez para toda a rede, a partir da soma
+das cargas das plataformas, descontando o parque eólico uma única vez,
+e dividida entre as plataformas na proporção de suas cargas. Quando
+ela passa da capacidade da termelétrica, a capacidade é dividida entre
+as plataformas. */
+typedef struct {
+    // Número de plataformas da rede.
+    int quantidade;
+    // Vetor de plataformas da rede, todas com o mesmo horário.
+    Plataforma *plataformas;
+    // Potência, em kW, consumida pelos componentes de cada plataforma
+    // em cada passo do trecho atual, sem descontar o parque eólico.
+    // Os passos de uma mesma plataforma são consecutivos.
+    double *cargas;
+    // Custo de cada passo do trecho atual por kW de carga, em reais.
+    double *fatores;
+    // Potência, em kW, que cada plataforma demanda da termelétrica no
+    // passo atual, antes da divisão. Só é calculada quando a demanda
+    // da rede passa da capacidade da termelétrica.
+    double *demandas;
+    // Potência, em kW, reservada para cada plataforma no passo atual.
+    double *cotas;
+    // Custo acumulado de cada plataforma, em reais.
+    double *custos;
+    // Número de passos em que a demanda total foi maior que a
+    // capacidade da termelétrica.
+    long passosComCorte;
+    // Critério de divisão da capacidade da termelétrica.
+    CriterioDeDivisao criterio;
+    // Política de corte de carga usada pelas plataformas, ou um
+    // apontador nulo para a política padrão.
+    const PoliticaDeCorte *politica;
+} Rede;
+
+/** Protótipos das funções públicas. */
+
+/* Retorna o tamanho, em bytes, que uma rede com a quantidade de
+plataformas padrão especificada ocupa em uma arena. */
+size_t tamanhoDaRede(int quantidade);
+
+/* Cria uma rede de plataformas padrão (25 séries de bombas e 10
+guindastes), cada uma com um navio de capacidade extrema, em uma
+arena. Retorna um apontador nulo se não houver espaço na arena. */
+Rede *CriarRedeNaArena(Arena *arena, int quantidade,
+                       CriterioDeDivisao criterio);
+
+/* Dá uma quantidade pré-determinada de passos em todas as plataformas
+da rede, acumulando o custo de cada uma. Retorna o custo total
+acumulado pela rede desde a sua criação. */
+double passosDaRede(Rede *rede, int64_t passos);
+
+#endif // _REDE
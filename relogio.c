@@ -0,0 +1,84 @@
+/** Relógio e calendário da simulação. O relógio é um único contador
+ *  de 64 bits, que avança um a cada passo; a hora do dia, a data, a
+ *  semana e o mês são calculados a partir dele apenas quando
+ *  necessários. O calendário tem anos de 365 dias, com os meses
+ *  usuais, para que os custos possam ser agrupados por dia e por mês.
+ */
+
+#include <stdint.h>
+
+#include "relogio.h"
+
+/* Número de dias de cada mês do ano. */
+static const int diasNoMes[MESES_NO_ANO] = {
+    31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+};
+
+/* Nome de cada mês do ano. */
+static const char *nomesDosMeses[MESES_NO_ANO] = {
+    "janeiro", "fevereiro", "março", "abril", "maio", "junho", "julho",
+    "agosto", "setembro", "outubro", "novembro", "dezembro"
+};
+
+/* Retorna o mês (de 0 a 11) de um dia do ano (de 0 a 364), e coloca o
+dia do mês (a partir de 0) no endereço de memória especificado. Função
+local. */
+static int mesDoDia(int diaDoAno, int *diaDoMes)
+{
+    int mes = 0;
+    while (diaDoAno >= diasNoMes[mes])
+    {
+        diaDoAno -= diasNoMes[mes];
+        mes++;
+    }
+    *diaDoMes = diaDoAno;
+    return mes;
+}
+
+/* Retorna o instante do relógio correspondente a um horário do
+primeiro dia. */
+Relogio relogioDoHorario(int hora, int minuto, int segundo)
+{
+    return (Relogio)hora * SEGUNDOS_NA_HORA + minuto * 60 + segundo;
+}
+
+/* Retorna o número de dias completos desde o início do relógio. */
+int64_t diaDoRelogio(Relogio relogio)
+{
+    return relogio / SEGUNDOS_NO_DIA;
+}
+
+/* Retorna o número de meses completos desde o início do relógio. */
+int64_t mesDoRelogio(Relogio relogio)
+{
+    int64_t dias = diaDoRelogio(relogio);
+    int diaDoMes;
+    return dias / DIAS_NO_ANO * MESES_NO_ANO
+           + mesDoDia(dias % DIAS_NO_ANO, &diaDoMes);
+}
+
+/* Calcula a data e o horário de um instante do relógio, e os coloca
+no endereço de memória especificado. */
+void calendarioDoRelogio(Relogio relogio, Calendario *calendario)
+{
+    int64_t dias = diaDoRelogio(relogio);
+    int segundos = segundosDoDia(relogio);
+    int diaDoAno = dias % DIAS_NO_ANO;
+    int diaDoMes;
+    calendario->ano = dias / DIAS_NO_ANO + 1;
+    calendario->mes = mesDoDia(diaDoAno, &diaDoMes) + 1;
+    calendario->dia = diaDoMes + 1;
+    calendario->diaDoAno = diaDoAno + 1;
+    calendario->dias = dias;
+    calendario->semana = dias / 7 + 1;
+    calendario->diaDaSemana = dias % 7 + 1;
+    calendario->hora = segundos / SEGUNDOS_NA_HORA;
+    calendario->minuto = segundos / 60 % 60;
+    calendario->segundo = segundos % 60;
+}
+
+/* Retorna o nome de um mês do ano (de 1 a 12). */
+const char *nomeDoMes(int mes)
+{
+    return nomesDosMeses[mes - 1];
+}
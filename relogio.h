@@ -0,0 +1,76 @@
+#ifndef _RELOGIO
+#define _RELOGIO
+
+#include <stdint.h>
+
+/* Segundos em uma hora e em um dia. */
+#define SEGUNDOS_NA_HORA (60 * 60)
+#define SEGUNDOS_NO_DIA (60 * 60 * 24)
+/* Dias em um ano do calendário da simulação, que não tem anos
+bissextos. */
+#define DIAS_NO_ANO 365
+/* Meses em um ano. */
+#define MESES_NO_ANO 12
+
+/** Relógio da simulação: o número de passos (segundos) desde as
+00:00.00 do dia 1º de janeiro do ano 1. Com 64 bits, o relógio nunca
+volta a zero, e horizontes de muitos anos podem ser simulados sem
+estouro. A hora do dia e o calendário são derivados dele. */
+typedef int64_t Relogio;
+
+/** Data e horário correspondentes a um instante do relógio. */
+typedef struct {
+    // Ano, a partir de 1.
+    int64_t ano;
+    // Mês do ano, de 1 a 12.
+    int mes;
+    // Dia do mês, a partir de 1.
+    int dia;
+    // Dia do ano, de 1 a 365.
+    int diaDoAno;
+    // Dias completos desde o início do relógio.
+    int64_t dias;
+    // Semana desde o início do relógio, a partir de 1.
+    int64_t semana;
+    // Dia da semana, de 1 a 7; o primeiro dia do relógio é o dia 1.
+    int diaDaSemana;
+    // Horário do dia.
+    int hora;
+    int minuto;
+    int segundo;
+} Calendario;
+
+/** Protótipos das funções públicas. */
+
+/* Retorna o instante do relógio correspondente a um horário do
+primeiro dia. */
+Relogio relogioDoHorario(int hora, int minuto, int segundo);
+
+/* Retorna a hora do dia (de 0 a 23) em um instante do relógio. É
+chamada a cada passo, por isso é definida aqui. */
+static inline int horaDoRelogio(Relogio relogio)
+{
+    return relogio % SEGUNDOS_NO_DIA / SEGUNDOS_NA_HORA;
+}
+
+/* Retorna o número de segundos desde as 00:00.00 do dia, em um
+instante do relógio. */
+static inline int segundosDoDia(Relogio relogio)
+{
+    return relogio % SEGUNDOS_NO_DIA;
+}
+
+/* Retorna o número de dias completos desde o início do relógio. */
+int64_t diaDoRelogio(Relogio relogio);
+
+/* Retorna o número de meses completos desde o início do relógio. */
+int64_t mesDoRelogio(Relogio relogio);
+
+/* Calcula a data e o horário de um instante do relógio, e os coloca
+no endereço de memória especificado. */
+void calendarioDoRelogio(Relogio relogio, Calendario *calendario);
+
+/* Retorna o nome de um mês do ano (de 1 a 12). */
+const char *nomeDoMes(int mes);
+
+#endif // _RELOGIO
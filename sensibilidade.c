@@ -0,0 +1,140 @@
+/** Calcula a sensibilidade do custo da energia aos parâmetros
+ *  contínuos do desafio (potências, eficiência dos inversores e preço
+ *  da energia da termelétrica) com números duais, em uma única
+ *  simulação, em vez de repeti-la para cada parâmetro perturbado.
+ */
+
+#include "energia.h"
+#include "sensibilidade.h"
+
+/* Parâmetros contínuos, na ordem de IndiceDoParametro. */
+const Parametro parametros[NUM_PARAMETROS] = {
+    {"P_GUINDASTE", "kW", P_GUINDASTE},
+    {"P_BOMBA", "kW", P_BOMBA},
+    {"P_AUXILIAR", "kW", P_AUXILIAR},
+    {"E_INVERSORES", "", E_INVERSORES},
+    {"C_TERMELETRICA", "R$/kWh", C_TERMELETRICA},
+};
+
+/* Retorna uma constante, cujas derivadas são nulas. Função local. */
+static Dual constante(double valor)
+{
+    Dual resultado = {valor, {0}};
+    return resultado;
+}
+
+/* Retorna o valor nominal de um parâmetro, cuja derivada em relação a
+ele mesmo é 1. Função local. */
+static Dual parametro(IndiceDoParametro indice)
+{
+    Dual resultado = constante(parametros[indice].valor);
+    resultado.derivadas[indice] = 1;
+    return resultado;
+}
+
+/* Retorna a + b. Função local. */
+static Dual somar(Dual a, Dual b)
+{
+    a.valor += b.valor;
+    for (int i = 0; i < NUM_PARAMETROS; i++)
+    {
+        a.derivadas[i] += b.derivadas[i];
+    }
+    return a;
+}
+
+/* Retorna a * k, sendo k uma constante. Função local. */
+static Dual escalar(Dual a, double k)
+{
+    a.valor *= k;
+    for (int i = 0; i < NUM_PARAMETROS; i++)
+    {
+        a.derivadas[i] *= k;
+    }
+    return a;
+}
+
+/* Retorna a * b. Função local. */
+static Dual multiplicar(Dual a, Dual b)
+{
+    Dual resultado = {a.valor * b.valor, {0}};
+    for (int i = 0; i < NUM_PARAMETROS; i++)
+    {
+        resultado.derivadas[i] = a.derivadas[i] * b.valor
+                                 + a.valor * b.derivadas[i];
+    }
+    return resultado;
+}
+
+/* Retorna a / b. Função local. */
+static Dual dividir(Dual a, Dual b)
+{
+    Dual resultado = {a.valor / b.valor, {0}};
+    for (int i = 0; i < NUM_PARAMETROS; i++)
+    {
+        resultado.derivadas[i] = (a.derivadas[i]
+                                  - resultado.valor * b.derivadas[i])
+                                 / b.valor;
+    }
+    return resultado;
+}
+
+/* Funciona como demandaDaPlataforma, mas retorna também as derivadas
+da potência, em kW, em relação a cada parâmetro contínuo. A potência é
+limitada à capacidade da termelétrica, como em ajustarDemanda. */
+Dual demandaDual(int bombasAtivas, int guindastesAtivos, int horario)
+{
+    Dual eficiencia = parametro(PARAMETRO_E_INVERSORES);
+    // Mesma sequência de operações de demandaDaPlataforma.
+    Dual demandaTotal = parametro(PARAMETRO_P_AUXILIAR);
+    demandaTotal = somar(demandaTotal,
+                         escalar(parametro(PARAMETRO_P_BOMBA),
+                                 bombasAtivas));
+    demandaTotal = somar(demandaTotal,
+                         escalar(parametro(PARAMETRO_P_GUINDASTE),
+                                 guindastesAtivos));
+    // Potência das turbinas, como em potenciaDasTurbinas.
+    Dual turbinas = escalar(eficiencia,
+                            potenciaPorTurbina(horario) * NUM_TURBINAS);
+    Dual demanda = somar(demandaTotal, escalar(turbinas, -1));
+    // Se a potência das turbinas é suficiente para suprir a demanda.
+    if (demanda.valor < 0)
+    {
+        return constante(0);
+    }
+    demanda = dividir(demanda, eficiencia);
+    // A termelétrica não fornece mais que a sua capacidade.
+    if (demanda.valor > P_TERMELETRICA)
+    {
+        return constante(P_TERMELETRICA);
+    }
+    return demanda;
+}
+
+/* Funciona como passosN, mas retorna, junto com o custo, as suas
+derivadas parciais em relação a cada parâmetro contínuo, calculadas na
+mesma passagem. As decisões discretas (componentes ligados, navios
+cheios) são as da simulação nominal, e são tratadas como constantes. */
+Dual passosComSensibilidade(int64_t passos, Bombas *bombas,
+                            Guindastes *guindastes, Relogio *relogio)
+{
+    double fracaoDaTermeletrica;
+    double custo = 0;
+    Dual sensibilidade = constante(0);
+    Dual preco = escalar(parametro(PARAMETRO_C_TERMELETRICA), 1.0 / 3600);
+    for (int64_t i = 0; i < passos; i++)
+    {
+        passo(bombas, guindastes, relogio, &fracaoDaTermeletrica, false);
+        // O valor é acumulado exatamente como em passosN, para que o
+        // custo seja idêntico ao do modo custo.
+        custo += fracaoDaTermeletrica * P_TERMELETRICA *
+                 C_TERMELETRICA / 3600;
+        // As derivadas vêm da demanda no estado após o passo, que é o
+        // estado em que ajustarDemanda a calculou.
+        Dual demanda = demandaDual(bombas->ativas, guindastes->ativos,
+                                   horaDoRelogio(*relogio));
+        sensibilidade = somar(sensibilidade, multiplicar(demanda, preco));
+    }
+    sensibilidade.valor = custo;
+    return sensibilidade;
+}
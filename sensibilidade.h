@@ -0,0 +1,56 @@
+#ifndef _SENSIBILIDADE
+#define _SENSIBILIDADE
+
+#include <stdint.h>
+
+#include "bombas.h"
+#include "guindastes.h"
+#include "relogio.h"
+
+/** Parâmetros contínuos do desafio em relação aos quais a
+sensibilidade do custo é calculada. */
+typedef enum {
+    PARAMETRO_P_GUINDASTE,
+    PARAMETRO_P_BOMBA,
+    PARAMETRO_P_AUXILIAR,
+    PARAMETRO_E_INVERSORES,
+    PARAMETRO_C_TERMELETRICA,
+    NUM_PARAMETROS
+} IndiceDoParametro;
+
+/** Descrição de um parâmetro contínuo do desafio. */
+typedef struct {
+    // Nome da constante correspondente.
+    const char *nome;
+    // Unidade do parâmetro, ou uma string vazia se ele for adimensional.
+    const char *unidade;
+    // Valor nominal do parâmetro.
+    double valor;
+} Parametro;
+
+/** Número dual: um valor acompanhado de suas derivadas parciais em
+relação a cada parâmetro contínuo, propagadas junto com ele pelas
+operações aritméticas (diferenciação automática no modo direto). */
+typedef struct {
+    double valor;
+    double derivadas[NUM_PARAMETROS];
+} Dual;
+
+/* Parâmetros contínuos, na ordem de IndiceDoParametro. */
+extern const Parametro parametros[NUM_PARAMETROS];
+
+/** Protótipos das funções públicas. */
+
+/* Funciona como demandaDaPlataforma, mas retorna também as derivadas
+da potência, em kW, em relação a cada parâmetro contínuo. A potência é
+limitada à capacidade da termelétrica, como em ajustarDemanda. */
+Dual demandaDual(int bombasAtivas, int guindastesAtivos, int horario);
+
+/* Funciona como passosN, mas retorna, junto com o custo, as suas
+derivadas parciais em relação a cada parâmetro contínuo, calculadas na
+mesma passagem. As decisões discretas (componentes ligados, navios
+cheios) são as da simulação nominal, e são tratadas como constantes. */
+Dual passosComSensibilidade(int64_t passos, Bombas *bombas,
+                            Guindastes *guindastes, Relogio *relogio);
+
+#endif // _SENSIBILIDADE
@@ -0,0 +1,83 @@
+/** Testa o núcleo do controlador embarcado no computador, compilado
+ *  com CONTROLADOR_EMBARCADO pelo alvo 'controlador' do makefile. Os
+ *  resultados esperados são os do programa completo: o custo do modo
+ *  custo e o tempo de carregamento de um navio padrão.
+ */
+
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "controlador.h"
+
+/* Custo mensal (30 dias) do modo custo do programa principal. */
+#define CUSTO_MENSAL 1190823.789
+/* Passos até um navio padrão, atracado às 00:00.00, ficar cheio, com
+todas as bombas e guindastes ativos (estimarNavio). */
+#define PASSOS_DO_NAVIO 1063649
+
+/* Número de verificações que falharam. */
+static int falhas = 0;
+
+/* Mostra o resultado de uma verificação. */
+static void verificar(bool condicao, const char *descricao)
+{
+    printf("%s: %s\n", condicao ? "ok" : "FALHOU", descricao);
+    if (!condicao)
+    {
+        falhas++;
+    }
+}
+
+int main(void)
+{
+    printf("Memória estática da plataforma: %zu bytes\n",
+           (size_t)MEMORIA_DO_CONTROLADOR);
+
+    // Operação contínua por 30 dias, como no modo custo.
+    Controlador *controlador = CriarControlador(0, INT_MAX);
+    verificar(controlador != NULL,
+              "a plataforma cabe na memória estática");
+    if (controlador == NULL)
+    {
+        return 1;
+    }
+    for (int i = 0; i < 60 * 60 * 24 * 30; i++)
+    {
+        passoDoControlador(controlador);
+    }
+    double custo = controlador->energia * C_TERMELETRICA;
+    printf("Custo de 30 dias: R$ %.3lf\n", custo);
+    verificar(fabs(custo - CUSTO_MENSAL) < 0.001,
+              "o custo de 30 dias é o do modo custo");
+    verificar(controlador->plataforma->relogio == 60 * 60 * 24 * 30,
+              "o relógio avança um segundo por passo");
+
+    // Um navio padrão, atracado às 00:00.00.
+    Controlador *outro = CriarControlador(0, CAPACIDADE_DO_NAVIO);
+    verificar(outro == controlador && outro->passos == 0
+              && outro->plataforma->relogio == 0,
+              "criar o controlador de novo o reinicia");
+    while (controlador->plataforma->guindastes->estadoDoNavio > 0)
+    {
+        passoDoControlador(controlador);
+    }
+    verificar(controlador->passos == PASSOS_DO_NAVIO,
+              "o navio fica cheio no mesmo passo do programa completo");
+
+    // Emergência: as bombas são desligadas e não podem ser religadas.
+    Bombas *bombas = controlador->plataforma->bombas;
+    emergenciaDoBombeamento(bombas);
+    alterarBombasAtivas(bombas, NUM_BOMBAS);
+    passoDoControlador(controlador);
+    verificar(bombas->ativas == 0 && bombas->luzVermelha,
+              "a emergência desliga e bloqueia as bombas");
+    normalizacaoDoBombeamento(bombas);
+    alterarBombasAtivas(bombas, NUM_BOMBAS);
+    verificar(bombas->ativas == NUM_BOMBAS,
+              "as bombas voltam depois da emergência");
+
+    printf("%s\n", falhas ? "Há falhas." : "Todas as verificações passaram.");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,74 @@
+/** Testa a divisão da termelétrica entre as plataformas de uma rede,
+ *  compilado pelo alvo 'teste_rede' do makefile. Fora do horário dos
+ *  guindastes, a rede padrão cabe na termelétrica, então não pode
+ *  haver corte de carga, qualquer que seja o critério de divisão ou a
+ *  política de corte, mesmo depois de um dia inteiro com cortes.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "rede.h"
+
+/* Número de plataformas da rede testada, suficiente para que a
+demanda passe da capacidade da termelétrica com os guindastes. */
+#define PLATAFORMAS_DO_TESTE 40
+
+/* Número de verificações que falharam. */
+static int falhas = 0;
+
+/* Mostra o resultado de uma verificação. */
+static void verificar(bool condicao, const char *descricao,
+                      const char *criterio, const char *politica)
+{
+    printf("%s: %s (%s, %s)\n", condicao ? "ok" : "FALHOU", descricao,
+           criterio, politica);
+    if (!condicao)
+    {
+        falhas++;
+    }
+}
+
+/* Simula um dia com cortes e confere que não há cortes nas horas da
+noite seguintes (00:00 - 01:00 e 14:00 - 15:00) com um critério de
+divisão e uma política de corte. */
+static void testarNoite(CriterioDeDivisao criterio, const char *nome,
+                        const PoliticaDeCorte *politica)
+{
+    Arena *arena = CriarArena(tamanhoDaRede(PLATAFORMAS_DO_TESTE));
+    if (arena == NULL)
+    {
+        falhas++;
+        return;
+    }
+    Rede *rede = CriarRedeNaArena(arena, PLATAFORMAS_DO_TESTE, criterio);
+    rede->politica = politica;
+    // Primeiro dia, até 00:00 do segundo.
+    passosDaRede(rede, SEGUNDOS_NO_DIA);
+    long cortes = rede->passosComCorte;
+    verificar(cortes > 0, "o primeiro dia tem cortes", nome,
+              politica->nome);
+    // 00:00 - 01:00 do segundo dia.
+    passosDaRede(rede, SEGUNDOS_NA_HORA);
+    verificar(rede->passosComCorte == cortes,
+              "nenhum corte entre 00:00 e 01:00", nome, politica->nome);
+    // 01:00 - 14:00, com cortes no turno da manhã, e 14:00 - 15:00.
+    passosDaRede(rede, 13 * SEGUNDOS_NA_HORA);
+    cortes = rede->passosComCorte;
+    passosDaRede(rede, SEGUNDOS_NA_HORA);
+    verificar(rede->passosComCorte == cortes,
+              "nenhum corte entre 14:00 e 15:00", nome, politica->nome);
+    removerArena(arena);
+}
+
+int main(void)
+{
+    for (int i = 0; i < NUM_POLITICAS_DE_CORTE; i++)
+    {
+        testarNoite(DIVISAO_JUSTA, "justa", &politicasDeCorte[i]);
+        testarNoite(DIVISAO_POR_PRIORIDADE, "prioridade",
+                    &politicasDeCorte[i]);
+    }
+    printf("%s\n", falhas ? "Há falhas." : "Todas as verificações passaram.");
+    return falhas ? 1 : 0;
+}